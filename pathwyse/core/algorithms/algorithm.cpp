@@ -1,7 +1,7 @@
 #include "algorithm.h"
 
 /** Algorithm management **/
-Algorithm::Algorithm(std::string name, Problem* problem){
+Algorithm::Algorithm(std::string name, Problem* problem, const SolverConfig& config): config(config){
     executionID = 0;
     algo_type = "NA";
     parallel = false;
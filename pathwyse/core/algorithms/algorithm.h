@@ -11,7 +11,7 @@ public:
 
     /** Algorithm management **/
     //Constructors and destructors
-    explicit Algorithm(std::string name, Problem* problem);
+    explicit Algorithm(std::string name, Problem* problem, const SolverConfig& config = SolverConfig());
     virtual ~Algorithm() = default;
 
     void initAlgorithm();
@@ -31,6 +31,9 @@ public:
     void setType(std::string type) {algo_type = type;}
     std::string getType() {return algo_type;}
 
+    //Configuration
+    const SolverConfig& getConfig() {return config;}
+
     //Problem data management
     Problem* getProblem() {return problem;}
     void setProblem(Problem* problem) {this->problem = problem;}
@@ -72,6 +75,7 @@ protected:
     std::string algo_type;
 
     //Configuration
+    SolverConfig config;
     bool parallel;
     bool bidirectional;
 
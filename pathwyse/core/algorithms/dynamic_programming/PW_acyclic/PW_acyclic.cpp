@@ -2,10 +2,10 @@
 
 /** Algorithm management **/
 //Constructors and destructors
-PWAcyclic::PWAcyclic(std::string name, Problem* problem): Algorithm(name, problem){
+PWAcyclic::PWAcyclic(std::string name, Problem* problem, const SolverConfig& config): Algorithm(name, problem, config){
     problem->initBoundLabels();
     label_manager = new LMacyclic(problem);
-    preprocess = new Preprocessing(name, problem);
+    preprocess = new Preprocessing(name, problem, config);
     initDataCollection();
     setStatus(ALGO_READY);
 }
@@ -31,17 +31,17 @@ bool PWAcyclic::preprocessing(){
     lower_bound = preprocess->getLowerBound();
     incumbent = preprocess->getIncumbent();
 
-    if(Parameters::getVerbosity() >= 1)
+    if(config.verbosity >= 1)
         std::cout << "Preprocessing time (s): " << preprocess->getGlobalTime() << std::endl;
 
     auto bestPath = preprocess->getBestSolution();
     if(bestPath and bestPath->getStatus() == PATH_OPTIMAL) {
         addSolution(*bestPath);
-        if(Parameters::getVerbosity() >= 2)
+        if(config.verbosity >= 2)
             std::cout<<"Optimal solution found during pre-processing...terminating"<<std::endl;
     }
     else if(problem->getStatus() != PROBLEM_INFEASIBLE) {
-        if(Parameters::getVerbosity() >= 2)
+        if(config.verbosity >= 2)
             std::cout<<"Feasible solution found during pre-processing...searching for an optimal solution"<<std::endl;
         search_required = true;
 
@@ -11,7 +11,7 @@ public:
 
     /** Algorithm management **/
     //Constructors and destructors
-    PWAcyclic(std::string name, Problem* problem);
+    PWAcyclic(std::string name, Problem* problem, const SolverConfig& config = SolverConfig());
     ~PWAcyclic();
 
     //Initialization
@@ -3,7 +3,7 @@
 
 /** LM management **/
 //Constructors and destructors
-LMDefault::LMDefault(Problem* problem) {
+LMDefault::LMDefault(Problem* problem, const SolverConfig& config): config(config) {
     executionID = 0;
     name = "label_manager";
     lm_type = "pqueue";
@@ -17,6 +17,7 @@ LMDefault::LMDefault(Problem* problem) {
 
     best_fw = nullptr;
     best_bw = nullptr;
+    completion_bounds = nullptr;
     iterations = 0;
 }
 
@@ -55,6 +56,7 @@ void LMDefault::initLM(){
     if(use_visited)
         forward_labels[0].initVisited(origin, n_nodes);
     forward_labels[0].setObjective(objective->getInitValue() + objective->getNodeCost(origin));
+    initSubsetRows(&forward_labels[0]);
 
     if(bidirectional) {
         backward_labels.emplace_back();
@@ -62,6 +64,7 @@ void LMDefault::initLM(){
         if(use_visited)
             backward_labels[0].initVisited(destination, n_nodes);
         backward_labels[0].setObjective(objective->getNodeCost(destination));
+        initSubsetRows(&backward_labels[0]);
     }
 
     for(int id = 0; id < problem->getNumRes(); id++) {
@@ -86,14 +89,14 @@ void LMDefault::initLM(){
 }
 
 void LMDefault::readConfiguration() {
-    bidirectional = Parameters::isDefaultBidirectional();
-    autoconfiguration = Parameters::isDefaultAutoConfigured();
-    split_ratio = Parameters::getDefaultSplit();
-    reserve_size = Parameters::getDefaultReserve();
-    compare_unreachables = Parameters::isDefaultUsingUnreachables();
-    use_visited = compare_unreachables or Parameters::isDefaultUsingVisited();
-    candidate_type = Parameters::getDefaultCandidateType();
-    join_type = Parameters::getDefaultJoinType();
+    bidirectional = config.bidirectional;
+    autoconfiguration = config.autoconfig;
+    split_ratio = config.split;
+    reserve_size = config.reserve;
+    compare_unreachables = config.compare_unreachables;
+    use_visited = compare_unreachables or config.use_visited;
+    candidate_type = config.candidate_type;
+    join_type = config.join_type;
 
     if(autoconfiguration) {
         //Simple auto-tune of some parameters
@@ -306,11 +309,24 @@ bool LMDefault::isExtensionFeasible(LabelAdv *label, int next_node) {
         current_value = resources[id]->extend(current_value, i, j, direction);
         if(!resources[id]->isFeasible(current_value, next_node, bounding, direction))
             return false;
+        if(resource_bounds and not isCompletionFeasible(id, current_value, next_node, direction))
+            return false;
     }
 
     return true;
 }
 
+//Checks if a label can still be completed, joining it with the cheapest completion of the resource
+bool LMDefault::isCompletionFeasible(int res_id, int value, int node, bool direction) {
+    int bound = resource_bounds->getBound(res_id, not direction, node);
+    if(bound == UNKNOWN)
+        return false;
+
+    Resource<int>* res = problem->getRes(res_id);
+    int consumption = direction ? res->join(value, bound, node) : res->join(bound, value, node);
+    return res->isFeasible(consumption);
+}
+
 bool LMDefault::isCriticalExtensionFeasible(LabelAdv *label, int next_node) {
     int current_value;
     bool direction = label->getDirection();
@@ -346,6 +362,7 @@ void LMDefault::extendLabel(LabelAdv *current_label, LabelAdv *new_label, int ne
     double current_value, new_value;
     current_value = current_label->getObjective();
     new_value = objective->extend(current_value, i, j, direction);
+    new_value += extendSubsetRows(new_label, next_node);
     new_label->setObjective(new_value);
 
     //Update resources
@@ -368,6 +385,54 @@ void LMDefault::updateUnreachables(LabelAdv *candidate) {
     }
 }
 
+//Subset row cuts
+//Sets the states of a label starting from its node
+void LMDefault::initSubsetRows(LabelAdv *label) {
+    label->initSubsetRows(problem->getSubsetRowCuts().size());
+    extendSubsetRows(label, label->getNode());
+}
+
+//Updates the states of a label entering a node, and returns the duals paid
+double LMDefault::extendSubsetRows(LabelAdv *label, int node) {
+    const SubsetRowCuts & cuts = problem->getSubsetRowCuts();
+    if(cuts.empty())
+        return 0;
+
+    Bitset & states = label->getSubsetRows();
+    for(auto & cut: cuts.getResets(node))
+        states.reset(cut);
+
+    double penalty = 0;
+    for(auto & cut: cuts.getCuts(node)) {
+        if(states.get(cut)) {
+            penalty += cuts.getDual(cut);
+            states.reset(cut);
+        }
+        else states.set(cut);
+    }
+    return penalty;
+}
+
+//Duals that l1 may pay on a completion while l2 does not: l1 dominates l2 only if its objective plus this value is not worse
+double LMDefault::dominanceSubsetRows(LabelAdv *l1, LabelAdv *l2) const {
+    const SubsetRowCuts & cuts = problem->getSubsetRowCuts();
+    double penalty = 0;
+    for(int cut = 0; cut < cuts.size(); cut++)
+        if(l1->getSubsetRows().get(cut) and not l2->getSubsetRows().get(cut))
+            penalty += cuts.getDual(cut);
+    return penalty;
+}
+
+//Duals paid when joining two labels, for the cuts half visited by both of them
+double LMDefault::joinSubsetRows(LabelAdv *forward, LabelAdv *backward) const {
+    const SubsetRowCuts & cuts = problem->getSubsetRowCuts();
+    double penalty = 0;
+    for(int cut = 0; cut < cuts.size(); cut++)
+        if(forward->getSubsetRows().get(cut) and backward->getSubsetRows().get(cut))
+            penalty += cuts.getDual(cut);
+    return penalty;
+}
+
 //Insertion
 //Objective based insert
 
@@ -387,6 +452,13 @@ LabelAdv* LMDefault::insert(LabelAdv* new_label) {
 
     const double objective = new_label->getObjective();
 
+    //Forward labels that cannot be completed into a path better than the incumbent
+    if(completion_bounds and direction) {
+        int value = new_label->getSnapshot(completion_bounds->getResourceId());
+        if(objective + completion_bounds->getBound(node, value) > incumbent)
+            return nullptr;
+    }
+
     auto & labels = direction ? forward_labels : backward_labels;
     auto & candidates = direction ? forward_candidates : backward_candidates;
     auto & best = direction ? forward_best : backward_best;
@@ -487,6 +559,11 @@ bool LMDefault::dominates(LabelAdv* l1, LabelAdv* l2) const {
         if(l1->getSnapshot(id) > l2->getSnapshot(id))
             return false;
 
+    //Subset row cuts dominance
+    if(not problem->getSubsetRowCuts().empty() and
+       l1->getObjective() + dominanceSubsetRows(l1, l2) > l2->getObjective())
+        return false;
+
     //Unreachable dominance
     if(compare_unreachables)
         return ((l1->getUnreachable()) & ~(l2->getUnreachable())).none();
@@ -496,7 +573,7 @@ bool LMDefault::dominates(LabelAdv* l1, LabelAdv* l2) const {
 
 /** Join **/
 void LMDefault::join(){
-    if(Parameters::getVerbosity() >= 4)
+    if(config.verbosity >= 4)
         std::cout<<"Joining..."<<std::endl;
 
     if(candidatesAvailable())
@@ -520,7 +597,7 @@ void LMDefault::join(){
 
 
 void LMDefault::closeLabels() {
-    if(Parameters::getVerbosity() >= 0)
+    if(config.verbosity >= 0)
         std::cout<<"Closing open labels to perform join operations..."<<std::endl;
 
     forward_closed_backup = forward_closed;
@@ -560,6 +637,7 @@ void LMDefault::naiveJoin(){
                             joinComparisons++;
                             label_backward = &backward_labels[backward_data.second];
                             cost = objective->join(label_forward->getObjective(), label_backward->getObjective(), i, j);
+                            cost += joinSubsetRows(label_forward, label_backward);
                             if(cost <= incumbent and
                                isJoinFeasible(label_forward, label_backward)) {
                                 incumbent = cost;
@@ -594,6 +672,7 @@ void LMDefault::classicJoin() {
                                     joinComparisons++;
                                     label_backward = &backward_labels[backward_data.second];
                                     cost = objective->join(label_forward->getObjective(), label_backward->getObjective(), i, j);
+                                    cost += joinSubsetRows(label_forward, label_backward);
                                     if (cost <= incumbent and
                                         isJoinFeasible(label_forward, label_backward)) {
                                         incumbent = cost;
@@ -646,12 +725,15 @@ void LMDefault::orderedJoin(){
                     for (auto &b: backward_closed[j]){
                         label_backward = &backward_labels[b.second];
                         cost = objective->join(label_forward->getObjective(), label_backward->getObjective() , i, j);
+                        cost += joinSubsetRows(label_forward, label_backward);
                         if (cost <= incumbent){
                             joinComparisons++;
                             if(isJoinFeasible(label_forward, label_backward)) {
                                 incumbent = cost;
                                 joinable_labels.insert(std::make_tuple(cost, label_forward, label_backward));
-                                break;
+                                //The next backward labels are not cheaper, unless they pay less subset row duals
+                                if(problem->getSubsetRowCuts().empty())
+                                    break;
                             }
                         }
                     }
@@ -741,6 +823,7 @@ std::list<LabelAdv> LMDefault::buildTour(std::list<int> tour, bool direction) {
 
     current_label->initLabel(node, nullptr, direction, problem->getNumRes());
     current_label->setObjective(problem->getObj()->getInitValue() + problem->getObj()->getNodeCost(node));
+    initSubsetRows(current_label);
 
     std::vector<Resource<int>*>& resources = problem->getResources();
     for(int id = 0; id < problem->getNumRes(); id++)
@@ -757,7 +840,7 @@ std::list<LabelAdv> LMDefault::buildTour(std::list<int> tour, bool direction) {
 }
 
 void LMDefault::findLabels(std::list<LabelAdv> *tourLabels) {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     int position;
@@ -796,7 +879,7 @@ void LMDefault::findLabels(std::list<LabelAdv> *tourLabels) {
 }
 
 void LMDefault::printStepConsumption(std::list<LabelAdv> *tourFW, std::list<LabelAdv> *tourBW) {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     std::vector<std::vector<int>> consumptionsFW, consumptionsBW;
@@ -834,7 +917,7 @@ void LMDefault::printStepConsumption(std::list<LabelAdv> *tourFW, std::list<Labe
 }
 
 void LMDefault::printCandidates(int id, bool direction) {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     std::cout<<"Printing all candidate labels for node " << id << " with direction " << direction << std::endl;
@@ -846,7 +929,7 @@ void LMDefault::printCandidates(int id, bool direction) {
 }
 
 void LMDefault::printClosed(int id, bool direction) {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     std::cout<<"Printing all closed labels for node " << id << " with direction " << direction << std::endl;
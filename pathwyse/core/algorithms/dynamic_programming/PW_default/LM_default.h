@@ -4,6 +4,7 @@
 #include <set>
 #include "algorithms/labels/label_advanced.h"
 #include "data/problem.h"
+#include "completion_bounds.h"
 
 //Queue based Label Manager for PW_default.
 //Handles data structures and returns candidates for the extension and join steps
@@ -14,7 +15,7 @@ public:
 
     /** LM management **/
     //Constructors and destructors
-    LMDefault(Problem* problem);
+    LMDefault(Problem* problem, const SolverConfig& config = SolverConfig());
     ~LMDefault() = default;
 
     //Initialization
@@ -31,6 +32,8 @@ public:
     void setProblem(Problem* problem) {this->problem = problem;}
     void setUseVisited(bool use_visited) {this->use_visited = use_visited;}
     void setCompareUnreachables(bool compare_unreachables) {this->compare_unreachables = compare_unreachables;}
+    void setResourceBounds(std::shared_ptr<ResourceBounds> bounds) {resource_bounds = bounds;}
+    void setCompletionBounds(CompletionBounds* bounds) {completion_bounds = bounds;}
 
     //Bidirectional budget management
     void update_split();
@@ -60,9 +63,16 @@ public:
     bool isNodeReachable(LabelAdv *label, int next_node);
     bool isExtensionFeasible(LabelAdv *label, int next_node);
     bool isCriticalExtensionFeasible(LabelAdv *label, int next_node);
+    bool isCompletionFeasible(int res_id, int value, int node, bool direction);
     void extendLabel(LabelAdv *current_label, LabelAdv *new_label, int next_node);
     void updateUnreachables(LabelAdv *label);
 
+    //Subset row cuts (see subset_row_data.h)
+    void initSubsetRows(LabelAdv *label);
+    double extendSubsetRows(LabelAdv *label, int node);
+    double dominanceSubsetRows(LabelAdv *l1, LabelAdv *l2) const;
+    double joinSubsetRows(LabelAdv *forward, LabelAdv *backward) const;
+
     //Label insertion
     LabelAdv* insert(LabelAdv *new_label);
     bool dominates (LabelAdv *l1, LabelAdv *l2) const;
@@ -115,6 +125,7 @@ protected:
     Problem* problem;
 
     //Parameters
+    SolverConfig config;
     bool bidirectional;
     bool autoconfiguration;
 
@@ -135,6 +146,11 @@ protected:
     // 0 = Only check the cost, 1 = Check the cost and the first resource, ...
     int n_resourse_dom;
 
+    //Minimum resource consumptions to complete a path from each node (optional)
+    std::shared_ptr<ResourceBounds> resource_bounds;
+    //Lower bounds on the cost to complete forward labels (optional, owned by the algorithm)
+    CompletionBounds* completion_bounds;
+
     //direction, index in the storage
     std::pair<bool, int> od_label;
 
@@ -4,8 +4,9 @@
 /** Algorithm management **/
 //Constructors and destructors
 
-PWDefault::PWDefault(std::string name, Problem* problem): Algorithm(name, problem){
-    label_manager = new LMDefault(problem);
+PWDefault::PWDefault(std::string name, Problem* problem, const SolverConfig& config): Algorithm(name, problem, config){
+    label_manager = new LMDefault(problem, config);
+    completion_bounds = nullptr;
     readConfiguration();
     initDataCollection();
     setStatus(ALGO_READY);
@@ -14,6 +15,7 @@ PWDefault::PWDefault(std::string name, Problem* problem): Algorithm(name, proble
 PWDefault::~PWDefault() {
     writeData();
     delete label_manager;
+    delete completion_bounds;
 }
 
 //Init and reset
@@ -21,6 +23,17 @@ void PWDefault::initAlgorithm() {
     //Data collection
     unreachable_max_count = 0;
 
+    if(config.resource_bounds)
+        applyResourceBounds();
+
+    //Completion bounds depend on the objective: they are computed again at each solve
+    if(config.completion_bounds >= 0 and config.completion_bounds < problem->getNumRes()) {
+        if(not completion_bounds)
+            completion_bounds = new CompletionBounds(problem, config.completion_bounds, config.completion_bounds_step);
+        completion_bounds->compute();
+        label_manager->setCompletionBounds(completion_bounds);
+    }
+
     if(use_visited) {
         //Determines which nodes will be checked for unreachability. Each node has its own bitset. Default value: 0.
         unreachable_active.resize(problem->getNumNodes(), Bitset(problem->getNumNodes()));
@@ -39,16 +52,31 @@ void PWDefault::initAlgorithm() {
     }
 }
 
+//Prunes unreachable nodes and passes the resource bounds to the label manager.
+//Bounds are computed on the first solve and kept in the problem until its graph or resources change.
+void PWDefault::applyResourceBounds() {
+    auto bounds = problem->getResourceBounds();
+    if(not bounds) {
+        Preprocessing preprocess(name, problem, config);
+        preprocess.setExecutionID(executionID);
+        bounds = preprocess.computeResourceBounds();
+        problem->setResourceBounds(bounds);
+    }
+    problem->resetActiveNodes();
+    problem->pruneUnreachableNodes(bounds->reachable);
+    label_manager->setResourceBounds(bounds);
+}
+
 void PWDefault::readConfiguration(){
-    timelimit = Parameters::getDefaultTimelimit();
-    parallel = Parameters::isDefaultParallel();
-    bidirectional = Parameters::isDefaultBidirectional();
-    dssr = Parameters::getDefaultDSSR();
-    ng = Parameters::getDefaultNG();
-    ng_size = Parameters::getDefaultNGSize();
-    earlyjoin = Parameters::isDefaultJoinEarly();
-    earlyjoin_step = Parameters::getDefaultJoinStep();
-    use_visited = Parameters::isDefaultUsingVisited();
+    timelimit = config.timelimit;
+    parallel = config.parallel;
+    bidirectional = config.bidirectional;
+    dssr = config.dssr;
+    ng = config.ng;
+    ng_size = config.ng_size;
+    earlyjoin = config.earlyjoin;
+    earlyjoin_step = config.earlyjoin_step;
+    use_visited = config.use_visited;
     algo_type = ALGO_EXACT;
 
     if(name == "PWDefaultRelaxDom") {
@@ -61,7 +89,7 @@ void PWDefault::readConfiguration(){
         dssr = DSSR_OFF;
         ng = NG_OFF;
         algo_type = ALGO_HEURISTIC;
-        label_manager->setQueueLimit(Parameters::getDefaultRelaxationQueueLimit());
+        label_manager->setQueueLimit(config.queue_limit);
     }
 }
 
@@ -100,7 +128,7 @@ void PWDefault::resetAlgorithm(int reset_level) {
 
 //Solve problem
 void PWDefault::solve(){
-    if(Parameters::getVerbosity() >= 4)
+    if(config.verbosity >= 4)
         std::cout<<"Solving..."<<std::endl;
 
     setStatus(ALGO_OPTIMIZING);
@@ -143,7 +171,7 @@ void PWDefault::solve(){
         collectData();
     }
 
-    if(Parameters::getVerbosity() >= 3)
+    if(config.verbosity >= 3)
         std::cout<<"Solving complete"<<std::endl;
 
     if(algo_status == ALGO_OPTIMIZING)
@@ -168,7 +196,7 @@ void PWDefault::labeling(bool forward, bool backward) {
         //Early Join
         if(forward and backward and bidirectional and earlyjoin and
                 earlyjoin_step <= label_manager->totalLabels()) {
-            if(Parameters::getVerbosity() >= 2)
+            if(config.verbosity >= 2)
                 std::cout << "Early join" << std::endl;
 
             if(earlyjoin_step < MAX_JOIN_STEP)
@@ -192,6 +220,9 @@ void PWDefault::extend(LabelAdv* candidate) {
 
     for(auto & neigh: neighbors) {
 
+        //Nodes masked out of a shared graph are skipped
+        if(not problem->isActiveNode(neigh)) continue;
+
         active = not unreachable_active.empty() and unreachable_active[node].get(neigh);
 
         if((active and label_manager->isNodeReachable(candidate, neigh)) or
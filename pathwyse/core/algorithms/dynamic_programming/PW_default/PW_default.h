@@ -2,6 +2,7 @@
 #define SPPRCLIB_DP_BIDIRECTIONAL_H
 
 #include "algorithms/algorithm.h"
+#include "algorithms/preprocessing/preprocessing.h"
 #include "LM_default.h"
 #include "algorithms/labels/label_advanced.h"
 
@@ -11,12 +12,13 @@ public:
 
     /** Algorithm management **/
     //Constructors and destructors
-    PWDefault(std::string name, Problem* problem);
+    PWDefault(std::string name, Problem* problem, const SolverConfig& config = SolverConfig());
     ~PWDefault();
 
     //Init and reset
     void initAlgorithm();
     void readConfiguration();
+    void applyResourceBounds();
 
     void resetIteration();
     void resetAlgorithm(int reset_level);
@@ -52,6 +54,7 @@ protected:
 
     //Label Manager
     LMDefault* label_manager;
+    CompletionBounds* completion_bounds;
 
     //Parameters (Configuration)
     float timelimit;            //timelimit (s)
@@ -0,0 +1,74 @@
+#include "completion_bounds.h"
+
+#include <limits>
+
+/** Bounds management **/
+//Constructors and destructors
+CompletionBounds::CompletionBounds(Problem* problem, int res_id, int step) {
+    this->problem = problem;
+    this->res_id = res_id;
+    this->step = std::max(step, 1);
+    obj = problem->getObj();
+    res = problem->getRes(res_id);
+    n_buckets = 0;
+}
+
+//Buckets are processed from the last one: a forward extension never lowers the resource value,
+//so each bucket only depends on itself and on the later ones.
+//Dependencies inside a bucket are solved by relaxation, a cycle of negative cost gives no bound.
+void CompletionBounds::compute() {
+    const double infinity = std::numeric_limits<double>::infinity();
+    const int n_nodes = problem->getNumNodes();
+    const int destination = problem->getDestination();
+
+    bounds.clear();
+    n_buckets = 0;
+    if(res->getUB() < 0 or res->getUB() >= INFPLUS)
+        return;
+
+    n_buckets = res->getUB() / step + 1;
+    bounds.resize(n_nodes, std::vector<double>(n_buckets, infinity));
+
+    for(int b = n_buckets - 1; b >= 0; b--) {
+        int value = b * step;
+        bounds[destination][b] = 0;
+
+        bool changed = true;
+        for(int pass = 0; pass < n_nodes and changed; pass++) {
+            changed = false;
+            for(int i = 0; i < n_nodes; i++) {
+                if(i == destination or not problem->isActiveNode(i))
+                    continue;
+
+                for(auto j: problem->getNeighbors(i, true)) {
+                    if(not problem->isActiveNode(j))
+                        continue;
+
+                    int next_value = res->extend(value, i, j, true);
+                    if(not res->isFeasible(next_value, j, 1, true) or next_value / step >= n_buckets)
+                        continue;
+
+                    double cost = obj->extend(0, i, j, true) + bounds[j][next_value / step];
+                    if(cost < bounds[i][b] - EPS) {
+                        bounds[i][b] = cost;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        if(changed)
+            for(int i = 0; i < n_nodes; i++)
+                bounds[i][b] = -infinity;
+    }
+}
+
+double CompletionBounds::getBound(int node, int value) {
+    if(n_buckets == 0 or value < 0)
+        return -std::numeric_limits<double>::infinity();
+
+    int b = value / step;
+    if(b >= n_buckets)
+        return std::numeric_limits<double>::infinity();
+    return bounds[node][b];
+}
@@ -0,0 +1,39 @@
+#ifndef COMPLETION_BOUNDS_H
+#define COMPLETION_BOUNDS_H
+
+#include "data/problem.h"
+
+//Lower bounds on the cost needed to complete a forward label, by node and by bucket of one resource.
+//They are computed with a backward DP relaxing elementarity and the other resources.
+
+class CompletionBounds {
+
+public:
+
+    /** Bounds management **/
+    //Constructors and destructors
+    CompletionBounds(Problem* problem, int res_id, int step);
+    ~CompletionBounds() = default;
+
+    //Backward DP over the buckets, to be run again whenever the objective changes
+    void compute();
+
+    //Lower bound on the cost from node to the destination, for a forward label with the given resource value
+    double getBound(int node, int value);
+    int getResourceId() {return res_id;}
+
+private:
+
+    Problem* problem;
+    Resource<double>* obj;
+    Resource<int>* res;
+
+    int res_id;
+    int step;
+    int n_buckets;
+
+    //bounds[node][b]: bound for the resource values greater or equal to b * step
+    std::vector<std::vector<double>> bounds;
+};
+
+#endif
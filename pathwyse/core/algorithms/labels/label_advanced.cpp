@@ -7,6 +7,7 @@ LabelAdv::LabelAdv(const LabelAdv &obj) : Label(obj) {
         visited = obj.visited;
         unreachable = obj.unreachable;
     }
+    subset_rows = obj.subset_rows;
 }
 
 //Init and updates
@@ -34,6 +35,7 @@ void LabelAdv::operator= (const LabelAdv& obj)  {
         visited = obj.visited;
         unreachable = obj.unreachable;
     }
+    subset_rows = obj.subset_rows;
 }
 
 bool LabelAdv::operator== (LabelAdv& obj)  {
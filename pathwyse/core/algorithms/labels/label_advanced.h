@@ -26,6 +26,10 @@ public:
     Bitset & getUnreachable(){return unreachable;}
     void setUnreachable(int node){unreachable.set(node);}
 
+    //Subset row cuts management: a state is set when the label visited an odd number of members of the cut
+    void initSubsetRows(int n_cuts) {subset_rows = Bitset(n_cuts);}
+    Bitset & getSubsetRows(){return subset_rows;}
+
     /** Operators **/
     void operator= (const LabelAdv& obj);
     bool operator== (LabelAdv& obj);
@@ -38,6 +42,7 @@ public:
 private:
     Bitset visited;
     Bitset unreachable;
+    Bitset subset_rows;
 };
 
 
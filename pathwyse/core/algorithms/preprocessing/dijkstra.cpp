@@ -2,7 +2,7 @@
 
 /** Algorithm management **/
 //Constructors and destructors
-Dijkstra::Dijkstra(std::string name, Problem* problem): Algorithm(name, problem) {
+Dijkstra::Dijkstra(std::string name, Problem* problem, const SolverConfig& config): Algorithm(name, problem, config) {
     visited = Bitset(problem->getNumNodes());
     distances.resize(problem->getNumNodes(), UNKNOWN);
     lower_bound = INFMINUS;
@@ -19,11 +19,15 @@ Dijkstra::Dijkstra(std::string name, Problem* problem): Algorithm(name, problem)
 }
 
 //Initialize algorithm
-void Dijkstra::initAlgorithm(bool direction, int res_id, double bounding) {
+//Consumption rounds bound the resource res_id, cost rounds track the critical resource.
+//In both cases the tracked resource is stored in the RES_CRITICAL snapshot of the labels.
+void Dijkstra::initAlgorithm(bool direction, int res_id, double bounding, bool completion) {
     bound_labels = problem->getBoundLabels();
     this->direction = direction;
     this->res_id = res_id;
     this->bounding = bounding;
+    this->completion = completion;
+    res = problem->getRes(res_id == RES_COST ? RES_CRITICAL : res_id);
     origin = direction ? problem->getOrigin() : problem->getDestination();
     destination = direction ? problem->getDestination() : problem->getOrigin();
     labels = res_id == RES_COST ? bound_labels->getCostLabels(direction) : bound_labels->getConsumptionLabels(res_id, direction);
@@ -55,15 +59,21 @@ void Dijkstra::solve() {
             pq.pop();
             continue;
         }
-        visited.set(current);
         current_label = &labels->at(current);
         cost = pq.top().first;
 
+        //Resource feasibility can depend on the node: without completion, only this node is discarded
+        if (not completion and not isLabelValid(current_label, distances[current])) {
+            pq.pop();
+            continue;
+        }
+        visited.set(current);
+
         if (not isLabelValid(current_label, cost))
             break;
 
         pq.pop();
-        if(round > 0)
+        if(completion and round > 0)
             joinCompletion(current_label);
 
         if (not isCriticalLabelValid(current_label, cost))
@@ -100,7 +110,7 @@ void Dijkstra::solve() {
                         continue;
                 }
 
-                if (isLabelValid(current_label, cost)) {
+                if (isLabelValid(&new_label, cost)) {
                     distances[node] = cost;
                     labels->at(node) = new_label;
                     pq.emplace(distances[node], node);
@@ -108,11 +118,13 @@ void Dijkstra::solve() {
             }
     }
 
-    checkFeasibility();
-    checkOptimality();
+    if(completion) {
+        checkFeasibility();
+        checkOptimality();
+    }
     round++;
 
-    if(Parameters::getVerbosity() >= 3) {
+    if(config.verbosity >= 3) {
         auto end_t = std::chrono::system_clock::now();
         std::chrono::duration<double> elapsed_seconds = end_t-start_t;
         std::cout << "Time: " << elapsed_seconds.count() << std::endl;
@@ -168,6 +180,7 @@ bool Dijkstra::isCriticalLabelValid(Label* l, int cost) {
 void Dijkstra::resetAlgorithm(int reset_level) {
     visited.reset();
     std::fill(distances.begin(), distances.end(), UNKNOWN);
+    pq = {};
     setStatus(ALGO_READY);
 }
 
@@ -220,7 +233,7 @@ bool Dijkstra::joinLabels(Label* l1, Label* l2){
 
 //Checks for feasibility and sets problem status
 void Dijkstra::checkFeasibility(){
-    if(round == 0 and Parameters::isPreprocessingCritical())
+    if(round == 0 and config.preprocessing_critical)
         return;
 
     //If status has already been set, return
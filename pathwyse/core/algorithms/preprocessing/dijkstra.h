@@ -10,10 +10,10 @@ class Dijkstra: public Algorithm {
 public:
     /** Algorithm management **/
     //Constructors and destructors
-    explicit Dijkstra(std::string name, Problem* problem);
+    explicit Dijkstra(std::string name, Problem* problem, const SolverConfig& config = SolverConfig());
     ~Dijkstra() = default;
 
-    void initAlgorithm(bool direction, int res_id, double bounding);
+    void initAlgorithm(bool direction, int res_id, double bounding, bool completion = true);
 
     //Solution process
     void solve() override;
@@ -34,7 +34,7 @@ public:
     //Returns the minimum distance for a node (from the source)
     int getDistance(int node){return distances[node];}
     //Returns the distance of a label (from the source)
-    int getDistance(Label * l){return res_id == RES_COST ? l->getObjective() : l->getSnapshot(res_id);}
+    int getDistance(Label * l){return res_id == RES_COST ? l->getObjective() : l->getSnapshot(RES_CRITICAL);}
 
     /** Solution management **/
     void managePaths();
@@ -51,6 +51,7 @@ private:
     double bounding;                //Resource split
     int res_id;
     int found_optimal;
+    bool completion;                //Joins with completion labels and updates the problem status
 
     //Resource and completion labels pointers
     Resource<double>* obj;
@@ -2,10 +2,10 @@
 #include "algorithms/preprocessing/dijkstra.h"
 
 /** Algorithm management **/
-Preprocessing::Preprocessing(std::string name, Problem* problem): Algorithm(name, problem) {
+Preprocessing::Preprocessing(std::string name, Problem* problem, const SolverConfig& config): Algorithm(name, problem, config) {
     initDataCollection();
-    dijkstra = new Dijkstra(name, problem);
-    preprocessingCritical = Parameters::isPreprocessingCritical();
+    dijkstra = new Dijkstra(name, problem, config);
+    preprocessingCritical = config.preprocessing_critical;
     if(preprocessingCritical)
         criticalActive = Bitset(problem->getNumNodes());
     round = 0;
@@ -43,7 +43,7 @@ bool Preprocessing::solveRound(bool direction, int res_id, double bounding){
 
     bool preprocess = true;
 
-    if(Parameters::getVerbosity() >= 3) {
+    if(config.verbosity >= 3) {
         if(round == 0) std::cout<<"--------"<<std::endl;
         std::cout<<"Preprocessing, round: "<< round << std::endl;
     }
@@ -66,7 +66,7 @@ bool Preprocessing::solveRound(bool direction, int res_id, double bounding){
         else {
             incumbent = dijkstra->getIncumbent();
             preprocessingCritical and res_id == RES_CRITICAL ? pruneCritical() : pruning();
-            if (Parameters::getVerbosity() >= 3) {
+            if (config.verbosity >= 3) {
                 std::cout << "Incumbent: " << incumbent << std::endl;
                 std::cout << "--------" << std::endl;
             }
@@ -83,6 +83,43 @@ bool Preprocessing::solveRound(bool direction, int res_id, double bounding){
     return preprocess;
 }
 
+//Runs a backward and a forward round on every resource, prunes unreachable nodes
+//and stores the minimum consumptions found for each node
+std::shared_ptr<ResourceBounds> Preprocessing::computeResourceBounds() {
+    collector.resetTimes();
+    collector.startGlobalTime();
+
+    auto bounds = std::make_shared<ResourceBounds>(problem->getNumRes(), problem->getNumNodes());
+    if(not problem->getBoundLabels())
+        problem->initBoundLabels();
+
+    for(int res_id = 0; res_id < problem->getNumRes(); res_id++)
+        for(bool direction: {false, true}) {
+            dijkstra->initAlgorithm(direction, res_id, 1, false);
+            dijkstra->solve();
+
+            Bitset & visited = dijkstra->getVisited();
+            for(int node = 0; node < problem->getNumNodes(); node++)
+                if(visited.get(node)) {
+                    auto & bound = direction ? bounds->fw_min[res_id][node] : bounds->bw_min[res_id][node];
+                    bound = problem->getBoundLabels()->getLabel(res_id, direction, node)->getSnapshot(RES_CRITICAL);
+                }
+
+            bounds->reachable &= visited;
+            pruning();
+            dijkstra->resetAlgorithm(0);
+            round++;
+        }
+
+    if(config.verbosity >= 3)
+        std::cout<<"Resource bounds computed, reachable nodes: " << bounds->reachable.count() << std::endl;
+
+    collector.stopGlobalTime();
+    collector.increment("iterations", 1);
+    collectData();
+    return bounds;
+}
+
 void Preprocessing::resetAlgorithm(int reset_level) {
     problem->resetBoundLabels();
     problem->resetActiveNodes();
@@ -116,7 +153,7 @@ double Preprocessing::getSplit() {
 //Prunes unreachable nodes
 void Preprocessing::pruning() {
     problem->pruneUnreachableNodes(dijkstra->getVisited());
-    if(Parameters::getVerbosity() >= 3)
+    if(config.verbosity >= 3)
         std::cout<<"Active nodes count after pruning " << problem->countActiveNodes()  << std::endl;
 }
 
@@ -126,7 +163,7 @@ void Preprocessing::pruneCritical(){
 
     if(round > 0)
         problem->pruneUnreachableNodes(criticalActive);
-    if(Parameters::getVerbosity() >= 3)
+    if(config.verbosity >= 3)
         std::cout<<"Active nodes count after pruning: " << problem->countActiveNodes()  << std::endl;
 }
 
@@ -10,13 +10,16 @@ public:
 
     /** Algorithm management **/
     //Constructors and destructors
-    explicit Preprocessing(std::string name, Problem* problem);
+    explicit Preprocessing(std::string name, Problem* problem, const SolverConfig& config = SolverConfig());
     ~Preprocessing() {delete dijkstra;}
 
     //Solution process
     void solve() override;
     bool solveRound(bool direction, int res_id, double bounding = 1);
 
+    //Resource-only rounds: they do not depend on the objective and can be reused while the graph is unchanged
+    std::shared_ptr<ResourceBounds> computeResourceBounds();
+
     void resetAlgorithm(int reset_level) override;
 
     //Compute split
@@ -2,6 +2,7 @@
 #define BOUND_DATA_H
 
 #include "algorithms/labels/label.h"
+#include "utils/bitset.h"
 
 struct BoundLabels {
 
@@ -53,5 +54,24 @@ private:
     std::vector<std::vector<Label>> fw_consumption, bw_consumption;
 };
 
+//Results of the resource-only preprocessing.
+//They depend on the graph and on the resource data, not on the objective: they stay valid until the graph changes.
+struct ResourceBounds {
+
+    ResourceBounds(int n_res, int n_nodes) {
+        reachable = Bitset(n_nodes);
+        reachable.set();
+        fw_min.resize(n_res, std::vector<int>(n_nodes, UNKNOWN));
+        bw_min.resize(n_res, std::vector<int>(n_nodes, UNKNOWN));
+    }
+    ~ResourceBounds() = default;
+
+    //Minimum consumption of a resource on a path from the origin (resp. to the destination), UNKNOWN if none
+    int getBound(int res_id, bool direction, int node) {return direction ? fw_min[res_id][node] : bw_min[res_id][node];}
+
+    //Nodes lying on at least one resource-feasible origin-destination path
+    Bitset reachable;
+    std::vector<std::vector<int>> fw_min, bw_min;
+};
 
 #endif
\ No newline at end of file
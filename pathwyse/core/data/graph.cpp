@@ -1,31 +1,48 @@
 #include "graph.h"
 
 #include <iostream>
+#include <algorithm>
 
 #include "utils/param.h"
 
 /** Graph management **/
 
 void Graph::initGraph(bool compress_data, int n_nodes, bool complete) {
-    this->compress_data = compress_data;
     this->n_nodes = n_nodes;
-    this->complete = complete;
+
+    topology = std::make_shared<GraphTopology>();
+    topology->n_nodes = n_nodes;
+    topology->compress_data = compress_data;
+    topology->complete = complete;
 
     if(not complete) {
         if(compress_data)
-            arcs_map.resize(n_nodes, std::map<int, bool>());
+            topology->arcs_map.resize(n_nodes, std::map<int, bool>());
         else
-            arcs.resize(n_nodes, Bitset(n_nodes));
+            topology->arcs.resize(n_nodes, Bitset(n_nodes));
     }
-    forward_neighbors.resize(n_nodes, std::vector<int>());
-    backward_neighbors.resize(n_nodes, std::vector<int>());
+    topology->forward_neighbors.resize(n_nodes, std::vector<int>());
+    topology->backward_neighbors.resize(n_nodes, std::vector<int>());
     active_nodes = Bitset(n_nodes);
     active_nodes.set();
+    node_mask.clear();
+}
+
+void Graph::shareTopology(const Graph & graph) {
+    n_nodes = graph.n_nodes;
+    topology = graph.topology;
+    active_nodes = Bitset(n_nodes);
+    active_nodes.set();
+    node_mask.clear();
 }
 
 /**  Coordinates and distances management **/
 
 int Graph::getCoordDistance(int i, int j) {
+    //Problems built without coordinates
+    if(x.empty())
+        return 0;
+
     const float s = Parameters::getCoordScaling();
 
     const double xi = x[i]*s, yi = y[i]*s;
@@ -78,13 +95,48 @@ double Graph::getEquirectangularDistance(double xi, double xj, double yi, double
 void Graph::setArc(int i, int j) {
     if(i == j) return;
 
-    if(not complete){
-        if(compress_data)
-            arcs_map[i].insert(std::make_pair(j, true));
+    if(not topology->complete){
+        if(topology->compress_data)
+            topology->arcs_map[i].insert(std::make_pair(j, true));
         else
-            arcs[i].set(j);
+            topology->arcs[i].set(j);
     }
 
-    forward_neighbors[i].push_back(j);
-    backward_neighbors[j].push_back(i);
-}
\ No newline at end of file
+    topology->forward_neighbors[i].push_back(j);
+    topology->backward_neighbors[j].push_back(i);
+}
+
+bool Graph::removeArc(int i, int j) {
+    if(not areNeighbors(i, j, true)) return false;
+
+    if(isTopologyShared())
+        topology = std::make_shared<GraphTopology>(*topology);
+
+    //A complete graph gets explicit arcs
+    if(topology->complete) {
+        topology->complete = false;
+        if(topology->compress_data) {
+            topology->arcs_map.assign(n_nodes, std::map<int, bool>());
+            for(int k = 0; k < n_nodes; k++)
+                for(int l : topology->forward_neighbors[k])
+                    topology->arcs_map[k].insert(std::make_pair(l, true));
+        }
+        else {
+            topology->arcs.assign(n_nodes, Bitset(n_nodes));
+            for(int k = 0; k < n_nodes; k++)
+                for(int l : topology->forward_neighbors[k])
+                    topology->arcs[k].set(l);
+        }
+    }
+
+    if(topology->compress_data)
+        topology->arcs_map[i].erase(j);
+    else
+        topology->arcs[i].set(j, false);
+
+    auto & forward = topology->forward_neighbors[i];
+    forward.erase(std::remove(forward.begin(), forward.end(), j), forward.end());
+    auto & backward = topology->backward_neighbors[j];
+    backward.erase(std::remove(backward.begin(), backward.end(), i), backward.end());
+    return true;
+}
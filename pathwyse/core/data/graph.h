@@ -8,9 +8,21 @@
 #include <vector>
 #include <math.h>
 #include <map>
+#include <memory>
 #include "utils/constants.h"
 #include "utils/bitset.h"
 
+//Arcs and adjacency lists of a graph.
+//Kept behind a shared pointer so that several problems defined on the same nodes can share a single copy.
+struct GraphTopology {
+    int n_nodes;
+    bool complete;
+    bool compress_data;
+    std::vector<Bitset> arcs;
+    std::vector<std::map<int, bool>> arcs_map;
+    std::vector<std::vector<int>> forward_neighbors, backward_neighbors;
+};
+
 class Graph {
 
 public:
@@ -22,6 +34,9 @@ public:
 
     //Data structure initialization
     void initGraph(bool compress_data, int n_nodes, bool complete);
+    //Share the topology of another graph. The topology is read-only: arcs must be set before sharing.
+    void shareTopology(const Graph & graph);
+    bool isTopologyShared() {return topology.use_count() > 1;}
 
     /**  Coordinates and distances management **/
     void initCoord(){x.resize(n_nodes); y.resize(n_nodes);}
@@ -36,20 +51,23 @@ public:
 
     /**  Arc management **/
     void setArc(int i, int j);
+    //Remove an arc. A shared topology is copied first, so that the other problems keep the arc.
+    //Returns false if the arc does not exist.
+    bool removeArc(int i, int j);
 
     //Neighbors management
     bool areNeighbors(int i, int j, bool direction) {
         if(i == j)
             return false;
-        if(complete)
+        if(topology->complete)
             return true;
 
         if(not direction)
             std::swap(i,j);
 
-        return compress_data ? arcs_map[i].count(j) : arcs[i].get(j);
+        return topology->compress_data ? topology->arcs_map[i].count(j) : topology->arcs[i].get(j);
     }
-    std::vector<int> & getNeighbors(int node, bool direction) {return direction ? forward_neighbors[node] : backward_neighbors[node];}
+    std::vector<int> & getNeighbors(int node, bool direction) {return direction ? topology->forward_neighbors[node] : topology->backward_neighbors[node];}
 
     /** Active nodes management **/
 
@@ -58,7 +76,11 @@ public:
     void pruneUnreachableNodes(Bitset & reachable){active_nodes &= reachable;}
     int countActiveNodes() {return active_nodes.count();}
     void activateNode(int i) {active_nodes.set(i);}
-    void resetActiveNodes(){active_nodes.set();}
+    void resetActiveNodes(){node_mask.empty() ? active_nodes.set() : active_nodes = node_mask;}
+
+    //Node mask: nodes outside the mask are never active, even after a reset
+    void setNodeMask(const Bitset & mask) {node_mask = mask; resetActiveNodes();}
+    void clearNodeMask() {node_mask.clear(); resetActiveNodes();}
 
     /** Utilities **/
     double toRadians(double degree) {return degree * (M_PI / 180.0);}
@@ -68,13 +90,9 @@ private:
     int n_nodes;
     std::vector<int> x, y;
     Bitset active_nodes;
+    Bitset node_mask;
 
-    bool complete;
-    bool compress_data;
-    std::vector<Bitset> arcs;
-    std::vector<std::map<int, bool>> arcs_map;
-
-    std::vector<std::vector<int>> forward_neighbors, backward_neighbors;
+    std::shared_ptr<GraphTopology> topology;
 };
 
 #endif
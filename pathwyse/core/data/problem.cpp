@@ -1,5 +1,6 @@
 #include "problem.h"
 #include <iostream>
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 
@@ -61,6 +62,20 @@ void Problem::initProblem(){
     initDataCollection();
 }
 
+//Initialize Problem on the network of another problem
+void Problem::initSharedProblem(Problem & shared){
+    compress_data = shared.compress_data;
+    n_nodes = shared.n_nodes;
+    origin = shared.origin;
+    destination = shared.destination;
+    n_arcs = shared.n_arcs;
+
+    //Share Network
+    network.shareTopology(shared.network);
+
+    //Initialize Data Collection
+    initDataCollection();
+}
 
 void Problem::printStatus(){
     std::string status;
@@ -86,6 +101,14 @@ void Problem::printStatus(){
 void Problem::setNetworkArc(int i, int j) {
     network.setArc(i, j);
     n_arcs++;
+    resetResourceBounds();
+}
+
+void Problem::removeNetworkArc(int i, int j) {
+    if(network.removeArc(i, j)) {
+        n_arcs--;
+        resetResourceBounds();
+    }
 }
 /** Objective and Resource management **/
 //Initialize Objective data structures
@@ -148,16 +171,20 @@ void Problem::setNodeConsumption(int id, std::vector<int> consumption) {
 
 void Problem::scaleObjective(float scaling) {
     objective->scaleResource(scaling);
+    subset_row_cuts.scaleDuals(scaling);
 }
 
 void Problem::scaleResource(int id, float scaling) {
     resources[id]->scaleResource(scaling);
+    resetResourceBounds();
 }
 
 void Problem::scaleAllData(float scaling) {
+    resetResourceBounds();
     objective->multiplyInitValue(scaling);
     objective->multiplyUB(scaling);
     objective->multiplyLB(scaling);
+    subset_row_cuts.scaleDuals(scaling);
 
     for(auto r: resources){
         r->multiplyInitValue(scaling);
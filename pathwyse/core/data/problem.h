@@ -12,6 +12,7 @@
 #include "utils/data_collector.h"
 #include "graph.h"
 #include "bound_data.h"
+#include "subset_row_data.h"
 #include "utils/bitset.h"
 
 class Problem {
@@ -27,6 +28,8 @@ public:
 
     //Problem setup
     void initProblem();
+    //Problem setup on the (read-only) graph of an initialized problem. Objective and resources are left to the caller.
+    void initSharedProblem(Problem & shared);
 
     //Name
     void setName(std::string name) {this->name = name;}
@@ -56,6 +59,8 @@ public:
     /** Graph management**/
     //Custom method : Add an arc to the underlying graph
     void setNetworkArc(int i, int j);
+    //Custom method : Remove an arc from the graph of this problem only (the graph may be shared)
+    void removeNetworkArc(int i, int j);
     //Get distance (coordinate based)
     int getCoordDistance(int i, int j) {return network.getCoordDistance(i, j);}
 
@@ -74,6 +79,10 @@ public:
 
     void resetActiveNodes() {network.resetActiveNodes();}
 
+    //Node mask, used to restrict a shared graph to the nodes available for this problem
+    void setNodeMask(const Bitset & mask) {network.setNodeMask(mask); resetResourceBounds();}
+    bool isNetworkShared() {return network.isTopologyShared();}
+
     /** Objective and Resource management **/
     //Objective initialization
     void initObjective(Resource<double>* objective = nullptr);
@@ -86,7 +95,7 @@ public:
     void createResources(std::vector<int> & resources_type);
     void setRes(Resource<int>* res){resources.push_back(res); n_res++;}
     void setRes(int position, Resource<int>* res){resources[position] = res;}
-    void setResources(std::vector<Resource<int>*> resources){this->resources = resources; n_res = resources.size();}
+    void setResources(std::vector<Resource<int>*> resources){this->resources = resources; n_res = resources.size(); resetResourceBounds();}
 
     //Insert sets of consumptions f
     void setArcConsumption(int i, int j,  std::vector<int> consumption);
@@ -104,6 +113,19 @@ public:
     BoundLabels* getBoundLabels(){return bound_labels;}
     void resetBoundLabels(){delete bound_labels; initBoundLabels();}
 
+    //Resource bounds are kept between solves, and dropped whenever the graph or the resource data change
+    void setResourceBounds(std::shared_ptr<ResourceBounds> bounds){resource_bounds = bounds;}
+    std::shared_ptr<ResourceBounds> getResourceBounds(){return resource_bounds;}
+    void resetResourceBounds(){resource_bounds.reset();}
+
+    /** Subset row cuts management **/
+    //Custom method : Cuts of the master problem whose duals are paid by the paths (see subset_row_data.h)
+    void addSubsetRowCut(const std::vector<int> & members, double dual, const std::vector<int> & memory = {}) {
+        subset_row_cuts.addCut(n_nodes, members, dual, memory);
+    }
+    void clearSubsetRowCuts() {subset_row_cuts.clear();}
+    const SubsetRowCuts & getSubsetRowCuts() const {return subset_row_cuts;}
+
     //Scaling
     void scaleObjective(float scaling);
     void scaleResource(int id, float scaling);
@@ -149,6 +171,10 @@ protected:
 
     //Completion Labels
     BoundLabels* bound_labels;
+    std::shared_ptr<ResourceBounds> resource_bounds;
+
+    //Subset row cuts
+    SubsetRowCuts subset_row_cuts;
 
     //Data collection
     DataCollector collector;
@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <stdexcept>
 
 template <typename T>
 struct ResourceData {
@@ -133,4 +135,38 @@ private:
     std::vector<std::vector<T>> arc_costs;
 };
 
+template <typename T>
+struct ResourceDataShared: ResourceData<T> {
+
+    /** Resource data management **/
+    //Constructors and Destructors
+    //Arc data is read from the shared data. Node costs start as a copy of the shared node costs
+    //and can then be overridden for this resource only (node-cost overlay).
+    explicit ResourceDataShared(std::shared_ptr<ResourceData<T>> shared_data, int n_nodes): ResourceData<T>(n_nodes) {
+        this->shared_data = shared_data;
+        ResourceData<T>::node_costs = shared_data->getNodeCost();
+    }
+    ~ResourceDataShared() = default;
+
+    void reset() override {ResourceData<T>::reset();}
+
+    /** Arc Data **/
+    //Shared arc data is read-only: writing it through one of the problems sharing it is an error
+    void setArcCost(int i, int j, T cost) override {throw std::logic_error("ResourceDataShared: arc data is read-only");}
+    void increaseArcCost(int i, int j, T delta) override {throw std::logic_error("ResourceDataShared: arc data is read-only");}
+    void multiplyArcCost(int i, int j, float factor) override {throw std::logic_error("ResourceDataShared: arc data is read-only");}
+    T getArcCost(int i, int j) override {return shared_data->getArcCost(i, j);}
+
+    /** Scaling **/
+    //Only the node overlay is scaled, the shared arc data is left untouched
+    void scaleData(float scaling) override{
+        int n_nodes = ResourceData<T>::n_nodes;
+        for(int i = 0; i < n_nodes; i++)
+            ResourceData<T>::multiplyNodeCost(i, scaling);
+    }
+
+private:
+    std::shared_ptr<ResourceData<T>> shared_data;
+};
+
 #endif
@@ -0,0 +1,69 @@
+#ifndef SUBSET_ROW_DATA_H
+#define SUBSET_ROW_DATA_H
+
+#include <vector>
+#include "utils/bitset.h"
+
+//Subset row cuts with multipliers 1/2 (e.g. 3-SRC) added to the master problem of a column generation.
+//A path pays the dual of a cut (added to its objective) each second time it visits a member of the cut.
+//With limited memory, a cut forgets the members already visited when the path goes through a node out of its memory.
+//The cuts are taken into account by the labels of PWDefault (extension, dominance and join).
+struct SubsetRowCuts {
+
+    /** Cuts management **/
+    //Constructors and destructors
+    SubsetRowCuts() = default;
+    ~SubsetRowCuts() = default;
+
+    //Adds a cut on the given nodes. An empty memory is the full memory (the cut never forgets).
+    void addCut(int n_nodes, const std::vector<int> & members, double dual, const std::vector<int> & memory = {}) {
+        if(node_cuts.empty()) {
+            node_cuts.resize(n_nodes);
+            node_resets.resize(n_nodes);
+        }
+        int cut = duals.size();
+        duals.push_back(dual);
+
+        for(auto & node: members)
+            node_cuts[node].push_back(cut);
+
+        if(not memory.empty()) {
+            Bitset in_memory(n_nodes);
+            for(auto & node: memory)
+                in_memory.set(node);
+            for(auto & node: members)
+                in_memory.set(node);
+            for(int node = 0; node < n_nodes; node++)
+                if(not in_memory.get(node))
+                    node_resets[node].push_back(cut);
+        }
+    }
+
+    void clear() {
+        duals.clear();
+        node_cuts.clear();
+        node_resets.clear();
+    }
+
+    void scaleDuals(float scaling) {
+        for(auto & dual: duals)
+            dual *= scaling;
+    }
+
+    /** Queries **/
+    int size() const {return duals.size();}
+    bool empty() const {return duals.empty();}
+    double getDual(int cut) const {return duals[cut];}
+
+    //Cuts having the node as a member
+    const std::vector<int> & getCuts(int node) const {return node_cuts[node];}
+    //Cuts having the node out of their memory
+    const std::vector<int> & getResets(int node) const {return node_resets[node];}
+
+private:
+
+    std::vector<double> duals;
+    std::vector<std::vector<int>> node_cuts, node_resets;
+};
+
+#endif
@@ -92,6 +92,7 @@ public:
     
     /** Resource data structure management **/
     void initData(bool compress_data = false, int n_nodes = 1) {compress_data ? data = new ResourceDataMap<T>(n_nodes): data = new ResourceDataMatrix<T>(n_nodes);}
+    void initSharedData(std::shared_ptr<ResourceData<T>> shared_data, int n_nodes) {data = new ResourceDataShared<T>(shared_data, n_nodes);}
     void setData(ResourceData<T>* data) {this->data = data;}
     ResourceData<T>* getData() {return data;}
 
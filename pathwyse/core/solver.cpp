@@ -1,5 +1,6 @@
 #include "solver.h"
 #include <filesystem>
+#include <algorithm>
 
 /** Solver Management **/
 
@@ -34,6 +35,26 @@ Solver::Solver(std::string file_path) {
     printWelcome();
 }
 
+/**
+ * Custom Solver Constructor. Builds the solver with a per-solver configuration.
+ * The static parameters are not modified, so several solvers with different configurations may coexist.
+ *
+ * @param config - Solver configuration.
+ */
+Solver::Solver(const SolverConfig& config) {
+    setStatus(SOLVER_START);
+    solver_version = "0.1";
+    optimization_round = 0;
+    problem = nullptr;
+    main_algorithm = nullptr;
+    default_instance = Parameters::getInstancePath();
+    this->config = config;
+    main_algorithm_name = config.main_algorithm_name;
+    ensemble_algorithms_names = config.ensemble_algorithms_names;
+    use_ensemble = config.use_ensemble;
+    setupOutput();
+    printWelcome();
+}
 
 /**
  * Solver Deconstructor. Destroys the solver.
@@ -53,7 +74,7 @@ Solver::~Solver() {
  * Prints welcome message and version to console.
  */
 void Solver::printWelcome() {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     std::cout << "PathWyse ver. " << solver_version << std::endl;
@@ -68,9 +89,10 @@ void Solver::printWelcome() {
 void Solver::readConfiguration(std::string file_path){
     if (!file_path.empty()) Parameters::readParameters(file_path);
     default_instance = Parameters::getInstancePath();
-    main_algorithm_name = Parameters::getMainAlgorithmName();
-    ensemble_algorithms_names = Parameters::getEnsembleNames();
-    use_ensemble = Parameters::isEnsembleUsed();
+    config = SolverConfig();
+    main_algorithm_name = config.main_algorithm_name;
+    ensemble_algorithms_names = config.ensemble_algorithms_names;
+    use_ensemble = config.use_ensemble;
 }
 
 /**
@@ -113,7 +135,7 @@ void Solver::setupOutput() {
  * @param verbosity - Verbosity level.
  */
 void Solver::setConsoleVerbosity(int verbosity) {
-    Parameters::setVerbosity(verbosity);
+    config.verbosity = verbosity;
 }
 
 // Problem management
@@ -204,7 +226,7 @@ void Solver::scaleData() {
     else
         problem->scaleAllData(Parameters::getScaling());
 
-    if(Parameters::getVerbosity() >= 1) {
+    if(config.verbosity >= 1) {
         std::cout<< "Performed scaling on target: " << target << std::endl;
         std::cout<< "Scaling: " << Parameters::getScaling() << std::endl;
     }
@@ -225,7 +247,7 @@ void Solver::revertScaleData() {
     else
         problem->scaleAllData(inv_scaling);
 
-    if(Parameters::getVerbosity() >= 1)
+    if(config.verbosity >= 1)
         std::cout<< "Reverted scaling on target: " << target << std::endl;
 }
 
@@ -239,7 +261,7 @@ void Solver::setupAlgorithms() {
         setMainAlgorithm(main_algorithm_name);
         setEnsemble(ensemble_algorithms_names);
         // If there are ensemble algorithms, print a message
-        if(Parameters::getVerbosity() >= 1 and ensemble_algorithms.size() > 0)
+        if(config.verbosity >= 1 and ensemble_algorithms.size() > 0)
             std::cout<<"Ensemble algorithms defined: "<< ensemble_algorithms_names.size() << std::endl;
     }
     else std::cout<<"Warning: no problem defined"<<std::endl;
@@ -253,9 +275,9 @@ void Solver::setupAlgorithms() {
  */
 Algorithm* Solver::createAlgorithm(std::string name){
     if(name == "PWAcyclic")
-        return new PWAcyclic(name, problem);
+        return new PWAcyclic(name, problem, config);
     else
-        return new PWDefault(name, problem);
+        return new PWDefault(name, problem, config);
 }
 
 // Algorithms: setters (name)
@@ -313,15 +335,15 @@ void Solver::solve() {
 
     setStatus(SOLVER_BUSY);
 
-    if(Parameters::getVerbosity() >= 0) {
+    if(config.verbosity >= 0) {
         std::cout<<"Solving problem..."<<std::endl;
-        if(Parameters::getVerbosity() >= 1)
+        if(config.verbosity >= 1)
             std::cout<<"Algorithm mode: " << (isEnsembleUsed() ? "ensemble" : "main algorithm") << std::endl;
     }
 
     isEnsembleUsed() ? solveEnsemble() : solveAlgorithm(MAIN_ALGORITHM);
 
-    if(Parameters::getVerbosity() >= 0)
+    if(config.verbosity >= 0)
         std::cout<<"--------------------"<<std::endl;
 
     printStatus();
@@ -358,7 +380,7 @@ void Solver::solveAlgorithm(int id) {
     if(not algorithm_solutions.empty())
         solutions.insert(solutions.end(), algorithm_solutions.begin(), algorithm_solutions.end());
 
-    if(Parameters::getVerbosity() >= 0)
+    if(config.verbosity >= 0)
         std::cout<< algorithm->getName() << " global time: " << algorithm->getGlobalTime() << std::endl;
 
 }
@@ -537,12 +559,12 @@ Path Solver::getBestSolution(){
  * Prints problem and algorithm status.
  */
 void Solver::printStatus() {
-    if(Parameters::getVerbosity() < 0)
+    if(config.verbosity < 0)
         return;
 
     problem->printStatus();
 
-    if(Parameters::getVerbosity() >= 1)
+    if(config.verbosity >= 1)
         isEnsembleUsed() ? printEnsembleStatus() : main_algorithm->printStatus();
     std::cout<<"--------------------"<<std::endl;
 }
@@ -551,7 +573,7 @@ void Solver::printStatus() {
  * Prints best solution found.
  */
 void Solver::printBestSolution() {
-    if(Parameters::getVerbosity() > 0)
+    if(config.verbosity > 0)
         std::cout<<"Best solution found:"<<std::endl;
 
     if(solutions.size() > 0)
@@ -14,6 +14,8 @@ public:
     Solver();
     // Custom constructor to load specified parameters from a file
     Solver(std::string file_path);
+    // Custom constructor using a per-solver configuration instead of the static parameters
+    Solver(const SolverConfig& config);
     ~Solver();
 
     //General solver methods
@@ -27,6 +29,7 @@ public:
 
     //Additional interfaces
     void setConsoleVerbosity(int verbosity);
+    const SolverConfig& getConfig() {return config;}
 
     /** Problem management **/
     void readProblem(std::string file_name = "");                                           //Use default problem/reader
@@ -99,6 +102,9 @@ private:
     int solver_status;                                  //Solver status
     int optimization_round;                             //Optimization round
 
+    //Configuration
+    SolverConfig config;                                //Configuration given to the algorithms
+
     //Problem
     Problem* problem;                                   //Problem
     std::string default_instance;                       //Instance name
@@ -50,6 +50,9 @@ bool Parameters::default_compare_unreachables = true;
 int Parameters::default_dssr = 1;
 int Parameters::default_ng = 0;
 int Parameters::default_ng_size = 8;
+bool Parameters::default_resource_bounds = false;
+int Parameters::default_completion_bounds = -1;
+int Parameters::default_completion_bounds_step = 10;
 
 int Parameters::default_candidate_type = 1;
 int Parameters::default_join_type = 2;
@@ -146,6 +149,12 @@ void Parameters::readParameters(std::string param_path) {
             }
             else if(command == "algo/default/ng/set_size")
                 default_ng_size = stoi(value);
+            else if(command == "algo/default/resource_bounds")
+                default_resource_bounds = stoi(value);
+            else if(command == "algo/default/completion_bounds")
+                default_completion_bounds = stoi(value);
+            else if(command == "algo/default/completion_bounds/step")
+                default_completion_bounds_step = stoi(value);
             else if(command == "algo/default/candidate/type") {
                 if(value == "round-robin")
                     default_candidate_type = CANDIDATE_RR;
@@ -222,9 +231,92 @@ void Parameters::setParametersFromDict(const std::map<std::string, std::any> &pa
         default_timelimit = std::any_cast<double>(params.at("time_limit"));
     if (params.contains("bidirectional"))
         default_bidirectional = std::any_cast<bool>(params.at("bidirectional"));
+    if (params.contains("resource_bounds"))
+        default_resource_bounds = std::any_cast<bool>(params.at("resource_bounds"));
+    if (params.contains("completion_bounds"))
+        default_completion_bounds = std::any_cast<int>(params.at("completion_bounds"));
+    if (params.contains("completion_bounds_step"))
+        default_completion_bounds_step = std::any_cast<int>(params.at("completion_bounds_step"));
     
 }
 
+/**Per-solver configuration**/
+SolverConfig::SolverConfig() {
+    verbosity = Parameters::getVerbosity();
+    main_algorithm_name = Parameters::getMainAlgorithmName();
+    ensemble_algorithms_names = Parameters::getEnsembleNames();
+    use_ensemble = Parameters::isEnsembleUsed();
+
+    preprocessing_critical = Parameters::isPreprocessingCritical();
+
+    timelimit = Parameters::getDefaultTimelimit();
+    parallel = Parameters::isDefaultParallel();
+    bidirectional = Parameters::isDefaultBidirectional();
+    use_visited = Parameters::isDefaultUsingVisited();
+    dssr = Parameters::getDefaultDSSR();
+    ng = Parameters::getDefaultNG();
+    ng_size = Parameters::getDefaultNGSize();
+    resource_bounds = Parameters::isDefaultUsingResourceBounds();
+    completion_bounds = Parameters::getDefaultCompletionBounds();
+    completion_bounds_step = Parameters::getDefaultCompletionBoundsStep();
+    earlyjoin = Parameters::isDefaultJoinEarly();
+    earlyjoin_step = Parameters::getDefaultJoinStep();
+
+    autoconfig = Parameters::isDefaultAutoConfigured();
+    split = Parameters::getDefaultSplit();
+    reserve = Parameters::getDefaultReserve();
+    compare_unreachables = Parameters::isDefaultUsingUnreachables();
+    candidate_type = Parameters::getDefaultCandidateType();
+    join_type = Parameters::getDefaultJoinType();
+
+    queue_limit = Parameters::getDefaultRelaxationQueueLimit();
+}
+
+SolverConfig SolverConfig::fromDict(const std::map<std::string, std::any> &params) {
+    SolverConfig config;
+    // Default parameters, shared by all modes
+    config.verbosity = -1;
+    config.ensemble_algorithms_names = {"PWDefaultRelaxDom","PWDefaultRelaxQueue"};
+    config.use_ensemble = false;
+    // Main algorithm parameters
+    config.main_algorithm_name = "PWDefault";
+    config.autoconfig = false;
+    config.timelimit = 0;
+    config.parallel = true;
+    config.bidirectional = false;
+    config.split = 0.5;
+    config.reserve = 10000000;
+    config.ng_size = 8;
+    config.candidate_type = CANDIDATE_NODE;
+    config.join_type = JOIN_ORDERED;
+    // We only expect the dict to relate to the following parameters
+    if(params.contains("verbosity"))
+        config.verbosity = std::any_cast<int>(params.at("verbosity"));
+    if (params.contains("use_visited"))
+        config.use_visited = std::any_cast<bool>(params.at("use_visited"));
+    if (params.contains("compare_unreachables"))
+        config.compare_unreachables = std::any_cast<bool>(params.at("compare_unreachables"));
+    if (params.contains("ng"))
+        config.ng = std::any_cast<int>(params.at("ng"));
+    if (params.contains("dssr"))
+        config.dssr = std::any_cast<int>(params.at("dssr"));
+    if (params.contains("time_limit"))
+        config.timelimit = std::any_cast<double>(params.at("time_limit"));
+    if (params.contains("bidirectional"))
+        config.bidirectional = std::any_cast<bool>(params.at("bidirectional"));
+    if (params.contains("resource_bounds"))
+        config.resource_bounds = std::any_cast<bool>(params.at("resource_bounds"));
+    if (params.contains("completion_bounds"))
+        config.completion_bounds = std::any_cast<int>(params.at("completion_bounds"));
+    if (params.contains("completion_bounds_step"))
+        config.completion_bounds_step = std::any_cast<int>(params.at("completion_bounds_step"));
+    if (params.contains("main_algorithm"))
+        config.main_algorithm_name = std::any_cast<std::string>(params.at("main_algorithm"));
+    if (params.contains("queue_limit"))
+        config.queue_limit = std::any_cast<int>(params.at("queue_limit"));
+
+    return config;
+}
 
 //Output path setup
 void Parameters::setupCollectionPath(){
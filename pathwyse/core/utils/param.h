@@ -64,6 +64,9 @@ struct Parameters {
     static int getDefaultDSSR(){return default_dssr;}
     static int getDefaultNG(){return default_ng;}
     static int getDefaultNGSize(){return default_ng_size;}
+    static bool isDefaultUsingResourceBounds(){return default_resource_bounds;}
+    static int getDefaultCompletionBounds(){return default_completion_bounds;}
+    static int getDefaultCompletionBoundsStep(){return default_completion_bounds_step;}
 
     static int getDefaultRelaxationQueueLimit(){return default_queue_limit;}
 
@@ -123,6 +126,9 @@ private:
     static int default_dssr;
     static int default_ng;
     static int default_ng_size;
+    static bool default_resource_bounds;
+    static int default_completion_bounds;
+    static int default_completion_bounds_step;
     static bool default_earlyjoin;
     static unsigned long long int default_earlyjoin_step;
 
@@ -144,4 +150,50 @@ private:
     static std::string collection_folder, collection_tag, collection_path;  //Global parameter
 };
 
+//Per-solver algorithm configuration.
+//By default, a configuration is a snapshot of the static Parameters, so that the static API keeps working.
+//Solvers and algorithms only read from their own configuration: several solvers can run concurrently
+//with different settings without touching the global parameters.
+struct SolverConfig {
+
+    SolverConfig();
+
+    //Builds a configuration from a dictionary, using the same keys and defaults as Parameters::setParametersFromDict
+    static SolverConfig fromDict(const std::map<std::string, std::any>& dict);
+
+    /**Solver Parameters**/
+    int verbosity;
+    std::string main_algorithm_name;
+    std::vector<std::string> ensemble_algorithms_names;
+    bool use_ensemble;
+
+    /**Preprocessing algorithm**/
+    bool preprocessing_critical;
+
+    /**Default Algorithm (PWDefault) Parameters**/
+    float timelimit;
+    bool parallel;
+    bool bidirectional;
+    bool use_visited;
+    int dssr;
+    int ng;
+    int ng_size;
+    bool resource_bounds;
+    int completion_bounds;          //Resource used for the completion bounds (-1: off)
+    int completion_bounds_step;
+    bool earlyjoin;
+    unsigned long long int earlyjoin_step;
+
+    //Label Manager
+    bool autoconfig;
+    double split;
+    int reserve;
+    bool compare_unreachables;
+    int candidate_type;
+    int join_type;
+
+    //Default algorithm relaxations parameters
+    int queue_limit;
+};
+
 #endif //SPPRCLIB_PARAM_H
@@ -8,6 +8,7 @@
 #include <queue>
 #include <chrono>
 #include <iostream>
+#include <optional>
 
 inline constexpr int GLOBAL_TIME_LIMIT = 3600;
 
@@ -21,13 +22,16 @@ double compute_x(int i, int j, int v,const MasterSolution& master_solution, cons
     return x_ijv;
 }
 
-std::tuple<int, int, int> find_first_valid_cut(const MasterSolution& master_solution, const std::vector<Route>& routes, const Instance& instance) {
+// The arcs already fixed by the node are never branched on again, nor the loops (a route only uses (i, i) when it is empty)
+std::tuple<int, int, int> find_first_valid_cut(const MasterSolution& master_solution, const std::vector<Route>& routes, const Instance& instance, const BPNode& node) {
     // Get the problem sizes
     int n_nodes = instance.nodes.size();
     int n_vehicles = instance.vehicles.size();
     for (int i = 0; i < n_nodes; i++) {
         for (int j = 0; j < n_nodes; j++) {
+            if (i == j) continue;
             for (int v = 0; v < n_vehicles; v++) {
+                if (node.upper_bound_cuts.contains({i, j, v}) || node.lower_bound_cuts.contains({i, j, v})) continue;
                 double x_ijv = compute_x(i, j, v, master_solution, routes, instance);
                 if (0.05 < x_ijv && x_ijv < 0.95) {
                     std::cout << "Found a valid cut at (" << i << ", " << j << ", " << v << ") with value " << x_ijv << std::endl;
@@ -39,10 +43,11 @@ std::tuple<int, int, int> find_first_valid_cut(const MasterSolution& master_solu
     return std::make_tuple(-1, -1, -1);
 }
 
-void branch_and_price(
+double branch_and_price(
     const Instance& instance, 
     std::vector<Route>& routes,
-    const BranchAndPriceParameters& parameters
+    const BranchAndPriceParameters& parameters,
+    double initial_objective
     ){
         using std::queue, std::vector;
         using std::cout, std::endl;
@@ -54,9 +59,20 @@ void branch_and_price(
         BPNode root_node = RootNode(routes);
         queue<BPNode> node_queue;
         node_queue.push(root_node);
+        // The bounds of the nodes and the solution values are compared in the maximisation formulation, whatever the
+        // formulation of the column generation (the minimisation objective is the total outsourcing cost minus it)
+        double total_outsource_cost = 0;
+        for (int i = 0; i < instance.number_interventions; i++) {
+            total_outsource_cost += instance.nodes[i].duration * instance.M;
+        }
+        auto maximisation_objective = [&](double objective) {
+            return parameters.use_maximisation_formulation ? objective : total_outsource_cost - objective;
+        };
         // We also keep track of the best node & corresponding solution value
-        BPNode best_node = BPNode(root_node);
-        double best_obj = 0;
+        // The known solution is the first incumbent, until a node beats it
+        std::optional<BPNode> best_node;
+        double best_obj = std::max(0., initial_objective);
+        cout << "Initial incumbent value : " << best_obj << endl;
 
         // Keep track of the number of nodes explored and the depth
         int depth = 0;
@@ -108,8 +124,8 @@ void branch_and_price(
                 continue;
             }
 
-            double integer_objective = result.integer_solution.objective_value;
-            double relaxed_objective = result.master_solution.objective_value;
+            double integer_objective = maximisation_objective(result.integer_solution.objective_value);
+            double relaxed_objective = maximisation_objective(result.master_solution.objective_value);
 
             // If we improved the best solution, keep the node in memory
             if (integer_objective > best_obj) {
@@ -124,7 +140,11 @@ void branch_and_price(
             }
 
             // We need to branch - find the first non integer x_ijv (for now)
-            auto ijv = find_first_valid_cut(result.master_solution, routes, instance);
+            auto ijv = find_first_valid_cut(result.master_solution, routes, instance, current_node);
+            if (std::get<0>(ijv) == -1) {
+                cout << "No fractional arc left to branch on - the node is not split" << endl;
+                continue;
+            }
 
             // Create the left (UB) and right (LB) node
             BPNode left_node = BPNode(current_node);
@@ -141,8 +161,14 @@ void branch_and_price(
 
         }
 
-
-        return;
+        cout << "---------------------------------" << endl;
+        cout << "Explored " << nodes_explored << " nodes up to depth " << depth << endl;
+        if (best_node) {
+            cout << "Best solution found at depth " << best_node->depth << " : " << best_obj << endl;
+        } else {
+            cout << "No node improved the initial solution : " << best_obj << endl;
+        }
+        return best_obj;
 }
 
 
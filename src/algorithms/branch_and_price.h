@@ -8,10 +8,15 @@
 #include <set>
 #include <vector>
 
-void branch_and_price(
+// Branch and price on the arcs of the vehicles, starting from the given routes
+// initial_objective is the value of a known integer solution made of these routes (in the maximisation formulation,
+// whatever the formulation of the column generation), used as the first incumbent to prune the nodes
+// Returns the value of the best integer solution (in the maximisation formulation), initial_objective if no node beats it
+double branch_and_price(
     const Instance& instance, 
     std::vector<Route>& routes,
-    const BranchAndPriceParameters& parameters
+    const BranchAndPriceParameters& parameters,
+    double initial_objective = 0
     );
 
 
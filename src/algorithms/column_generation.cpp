@@ -3,6 +3,8 @@
 #include "master_problem/master_solver.h"
 #include "master_problem/rmp_solver.h"
 #include "master_problem/node.h"
+#include "master_problem/column_pool.h"
+#include "master_problem/subset_row_cuts.h"
 
 #include "routes/route_optimizer.h"
 
@@ -23,32 +25,235 @@
 #include <execution>
 #include <random>
 #include <thread>
+#include <future>
+#include <optional>
+#include <algorithm>
 
 inline constexpr int S_TO_MS = 1000;
-
-
-std::map<std::string, std::any> pathwyse_parameters_dict(
+// Penalty of the artificial variables of the rows x_ijv >= 1, relative to the total outsourcing cost
+inline constexpr double BRANCHING_PENALTY_FACTOR = 10;
+// Share of the time left in a pricing round given to each of the tiers before the last one (the heuristic tiers)
+inline constexpr double HEURISTIC_TIER_TIME_SHARE = 0.1;
+// Smallest time limit of a Pathwyse tier (a time limit of 0 means no limit)
+inline constexpr double MIN_TIER_TIME_LIMIT = 0.01;
+
+
+// Build the Pathwyse configuration used for one pricing round
+// Each solver gets its own copy, so the global Pathwyse parameters are never modified during the column generation
+// time_resource is the position of the time window resource in the pricing problems (after the capacities)
+SolverConfig pathwyse_solver_config(
     const ColumnGenerationParameters& parameters,
     double remaining_time,
+    int time_resource,
     bool using_cyclic_pricing = false
 ){
-    return std::map<std::string, std::any>({
+    return SolverConfig::fromDict({
         {"time_limit", remaining_time},
         {"verbosity", -1},
         {"use_visited", parameters.use_visited},
         {"ng", parameters.ng},
         {"dssr", parameters.dssr},
         {"compare_unreachables", using_cyclic_pricing},
-        {"bidirectional", parameters.bidirectional_DP}
+        {"bidirectional", parameters.bidirectional_DP},
+        {"resource_bounds", parameters.use_resource_bounds},
+        {"completion_bounds", parameters.use_completion_bounds ? time_resource : -1},
+        {"completion_bounds_step", parameters.completion_bounds_step},
+        {"queue_limit", parameters.heuristic_queue_limit}
+    });
+}
+
+
+// Solve the pricing problems of one round with the pricing function defined in the parameters
+std::vector<Route> solve_pricing_round(
+    const Instance & instance,
+    const ColumnGenerationParameters& parameters,
+    const DualSolution & dual_solution,
+    const std::vector<int> & vehicle_order,
+    bool using_cyclic_pricing,
+    int n_ressources_dominance,
+    const SolverConfig & config,
+    std::vector<SharedPricingProblems> & pricing_groups,
+    int iteration,
+    bool has_branching_cuts = false
+){
+    std::vector<Route> new_routes;
+    // The grouped pulse prices all the vehicles of a depot on the same graph, which can not hold the arcs forbidden
+    // to a single vehicle by the branching : the vehicles are then priced one by one
+    std::string pricing_function = parameters.pricing_function;
+    if (has_branching_cuts && pricing_function == PRICING_PA_GROUPED){
+        pricing_function = PRICING_PA_BASIC;
+    }
+    if (has_branching_cuts && (pricing_function == PRICING_MPA_GROUPED || pricing_function == PRICING_MPA_GROUPED_PAR)){
+        pricing_function = PRICING_MPA;
+    }
+    if (pricing_function == PRICING_PATHWYSE_BASIC){
+        new_routes = full_pricing_problems_basic(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            using_cyclic_pricing,
+            n_ressources_dominance,
+            config,
+            pricing_groups
+        );
+    } else if (pricing_function == PRICING_DIVERSIFICATION){
+        new_routes = full_pricing_problems_diversification(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            using_cyclic_pricing,
+            n_ressources_dominance,
+            config,
+            iteration
+        );
+    } else if (pricing_function == PRICING_CLUSTERING){
+        new_routes = full_pricing_problems_clustering(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            using_cyclic_pricing,
+            n_ressources_dominance,
+            config,
+            iteration
+        );
+    } else if (pricing_function == PRICING_PA_BASIC){
+        new_routes = full_pricing_problems_basic_pulse(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            parameters.delta,
+            parameters.solution_pool_size,
+            parameters.pricing_verbose
+        );
+    } else if (pricing_function == PRICING_PA_GROUPED){
+        auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
+        new_routes = full_pricing_problems_grouped_pulse(
+            dual_solution,
+            instance,
+            vehicle_groups,
+            parameters.use_maximisation_formulation,
+            parameters.delta,
+            parameters.solution_pool_size,
+            parameters.pricing_verbose
+        );
+    } else if (pricing_function == PRICING_MPA) {
+        new_routes = full_pricing_problems_multithreaded_pulse(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            parameters.delta,
+            parameters.solution_pool_size,
+            parameters.pricing_verbose
+        );
+    } else if (pricing_function == PRICING_MPA_GROUPED){
+        auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
+        new_routes = full_pricing_problems_grouped_pulse_multithreaded(
+            dual_solution,
+            instance,
+            vehicle_groups,
+            parameters.use_maximisation_formulation,
+            parameters.delta,
+            parameters.solution_pool_size,
+            parameters.pricing_verbose
+        );
+    } else if (pricing_function == PRICING_MPA_GROUPED_PAR){
+        auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
+        new_routes = full_pricing_problems_grouped_pulse_par_par(
+            dual_solution,
+            instance,
+            vehicle_groups,
+            parameters.use_maximisation_formulation,
+            parameters.delta,
+            parameters.solution_pool_size,
+            parameters.pricing_verbose
+        );
+    } else if (pricing_function == PRICING_TABU_SEARCH){
+        new_routes = full_pricing_problems_tabu_search(
+            dual_solution,
+            instance,
+            vehicle_order,
+            parameters.use_maximisation_formulation,
+            parameters.tabu_iterations,
+            parameters.tabu_tenure
+        );
+    } else if (pricing_function == PRICING_PW_PA) {
+        // Begin by solving the Pathwyse heuristic
+        if (!using_cyclic_pricing){
+            new_routes = full_pricing_problems_basic(
+                dual_solution,
+                instance,
+                vehicle_order,
+                parameters.use_maximisation_formulation,
+                using_cyclic_pricing,
+                n_ressources_dominance,
+                config,
+                pricing_groups
+            );
+        } else {
+            // Then, solve the PA
+            new_routes = full_pricing_problems_basic_pulse(
+                dual_solution,
+                instance,
+                vehicle_order,
+                parameters.use_maximisation_formulation,
+                parameters.delta,
+                parameters.solution_pool_size,
+                parameters.pricing_verbose
+            );
+        }
+    }
+    return new_routes;
+}
+
+
+// Whether the pricing round is solved by a Pathwyse algorithm, and can therefore use the pricing tiers
+bool is_pathwyse_pricing(const std::string & pricing_function, bool using_cyclic_pricing){
+    if (pricing_function == PRICING_PW_PA){
+        return !using_cyclic_pricing;
+    }
+    return pricing_function == PRICING_PATHWYSE_BASIC
+        || pricing_function == PRICING_DIVERSIFICATION
+        || pricing_function == PRICING_CLUSTERING;
+}
+
+
+// Whether the vehicle of a route can still do all its interventions in the instance
+bool is_route_in_instance(const Route& route, const Instance& instance){
+    if (route.id_sequence.size() <= 2){
+        return true;
+    }
+    const Vehicle& vehicle = instance.vehicles[route.vehicle_id];
+    return std::all_of(route.id_sequence.begin() + 1, route.id_sequence.end() - 1, [&vehicle](int i){
+        return vehicle.reverse_interventions[i] != -1;
     });
 }
 
 
+// Whether one of the routes would be added to the master problem
+bool has_improving_route(const std::vector<Route> & routes, const ColumnGenerationParameters& parameters){
+    for (const Route& route : routes){
+        if (parameters.use_maximisation_formulation && route.reduced_cost > parameters.reduced_cost_threshold){
+            return true;
+        }
+        if (!parameters.use_maximisation_formulation && route.reduced_cost < - parameters.reduced_cost_threshold){
+            return true;
+        }
+    }
+    return false;
+}
+
+
 CGResult column_generation(
     const Instance & instance,
     BPNode & node,
     std::vector<Route> & routes,
-    const ColumnGenerationParameters& parameters
+    const ColumnGenerationParameters& parameters,
+    const DualSolution & initial_dual_solution
     ){
     using std::cout, std::endl;
     using std::setprecision, std::fixed;
@@ -73,6 +278,37 @@ CGResult column_generation(
         vehicle_ctrs,
         parameters.use_maximisation_formulation
     );
+    // The branching decisions of the node are imposed on the pricing graphs through the vehicles of the pricing instance
+    // The routes that do not respect them are kept out of the master problem, as well as the routes that the vehicles
+    // of the instance can not do (the residual instances of the diving heuristic remove interventions from the vehicles)
+    bool has_branching_cuts = !node.upper_bound_cuts.empty() || !node.lower_bound_cuts.empty();
+    std::optional<Instance> node_instance;
+    if (has_branching_cuts){
+        node_instance = branching_instance(instance, node);
+    }
+    for (int r = 0; r < routes.size(); r++){
+        if (!is_route_in_instance(routes[r], instance) || (has_branching_cuts && !respects_branching_cuts(routes[r], node, instance))){
+            route_vars[r].set(GRB_DoubleAttr_UB, 0.0);
+        }
+    }
+    const Instance& pricing_instance = has_branching_cuts ? *node_instance : instance;
+    // Total outsourcing cost, the constant between the two formulations
+    double total_outsource_cost = 0;
+    for (int i = 0; i < instance.number_interventions; i++){
+        total_outsource_cost += instance.nodes[i].duration * instance.M;
+    }
+    // The rows x_ijv >= 1 of the node, with their artificial variables
+    // The routes priced on the node instance only use (i, j) to visit i : their duals are paid on i (see vehicle_alphas)
+    std::map<std::tuple<int, int, int>, GRBConstr> branching_ctrs;
+    vector<GRBVar> artificial_vars;
+    add_branching_rows(model, node, routes, route_vars, branching_ctrs, artificial_vars,
+        BRANCHING_PENALTY_FACTOR * total_outsource_cost, parameters.use_maximisation_formulation);
+    // Subset row cuts, separated each time the pricing finds no route (only valid in the maximisation formulation)
+    std::map<SubsetRowCut, GRBConstr> subset_row_ctrs;
+    // Memories of the cuts of the model, empty for the full memory
+    std::map<SubsetRowCut, std::vector<int>> subset_row_memories;
+    bool use_subset_row_cuts = parameters.use_subset_row_cuts && parameters.use_maximisation_formulation;
+    int n_separation_rounds = 0;
 
     // Main loop of the column generation algorithm
     int iteration = 0;
@@ -83,9 +319,12 @@ CGResult column_generation(
 
     // Master Solutions - Do a first solve before the loop
     int status = solve_model(model);
-    MasterSolution solution = extract_solution(model, route_vars, intervention_ctrs, vehicle_ctrs);
+    MasterSolution solution = extract_solution(model, route_vars, intervention_ctrs, vehicle_ctrs, subset_row_ctrs, branching_ctrs, subset_row_memories);
     DualSolution& dual_solution = solution.dual_solution;
-    DualSolution previous_dual_solution{};
+    // Stabilisation center, possibly carried over from a previous run
+    DualSolution previous_dual_solution = initial_dual_solution;
+    bool has_stabilisation_center = initial_dual_solution.alphas.size() == instance.number_interventions
+        && initial_dual_solution.betas.size() == instance.number_vehicles;
 
     // Intermediary integer solutions
     IntegerSolution intermediary_integer_solution {};
@@ -93,21 +332,36 @@ CGResult column_generation(
     if (parameters.compute_intermediate_integer_solutions){
         cout << "Solving intermediary integer model at iteration " << iteration << endl;
         intermediary_integer_solution = solve_intermediary_integer_model(model, route_vars, postpone_vars, parameters.time_limit);
+        std::tie(intermediary_integer_solution, intermediary_integer_routes) = extract_used_routes(routes, intermediary_integer_solution);
     }
+    // Only the routes used in an integer solution are kept (and repaired)
+    // The solution only covers the routes existing when it was launched, the routes vector only grows in between
+    // A failed or stopped solve gives an infeasible solution, which does not replace the current one
+    BackgroundIntegerSolve integer_solve;
+    auto publish_integer_solution = [&](const IntegerSolution& integer_solution){
+        if (!integer_solution.is_feasible){
+            return;
+        }
+        if (!parameters.use_maximisation_formulation){
+            std::tie(intermediary_integer_solution, intermediary_integer_routes) = compute_repaired_solution(routes, integer_solution, instance);
+        } else {
+            std::tie(intermediary_integer_solution, intermediary_integer_routes) = extract_used_routes(routes, integer_solution);
+        }
+    };
 
     // Objective values tracking
     vector<double> objective_values = {solution.objective_value};
     vector<double> solution_costs = {relaxed_solution_cost(solution, routes)};
     vector<double> covered_interventions = {count_covered_interventions(solution, routes, instance)};
     vector<double> integer_objective_values = {intermediary_integer_solution.objective_value};
-    vector<int> integer_covered_interventions = {count_covered_interventions(intermediary_integer_solution, routes, instance)};
-    vector<double> integer_solution_costs = {integer_solution_cost(intermediary_integer_solution, routes)};
+    vector<int> integer_covered_interventions = {count_covered_interventions(intermediary_integer_solution, intermediary_integer_routes, instance)};
+    vector<double> integer_solution_costs = {integer_solution_cost(intermediary_integer_solution, intermediary_integer_routes)};
     vector<int> time_points = {0};
 
     // Order of exploration of the vehicles for the pricing problem (does not matter, we simply remove the vehicles that can not be used)
     vector<int> vehicle_order = {};
     for (int v = 0; v < instance.number_vehicles; v++){
-        if (instance.vehicles[v].interventions.size() > 0){
+        if (pricing_instance.vehicles[v].interventions.size() > 0){
             vehicle_order.push_back(v);
         }
     }
@@ -120,6 +374,20 @@ CGResult column_generation(
         max_resources_dominance = instance.capacities_labels.size() + 1;
     }
 
+    // Pathwyse pricing problems, kept between iterations (only the duals change)
+    vector<SharedPricingProblems> pricing_groups;
+
+    // Pricing tiers, and the number of rounds in which each tier was the last one used
+    vector<string> pricing_tiers = parameters.pricing_tiers;
+    if (pricing_tiers.empty()){
+        pricing_tiers = {"PWDefault"};
+    }
+    vector<int> pricing_tiers_usage(pricing_tiers.size(), 0);
+    // Rounds of the pricing functions that do not use the tiers (not counted in the tiers usage)
+    int untiered_pricing_rounds = 0;
+    // Number of pricing rounds solved again at the current duals because of the smoothing
+    int n_mispricings = 0;
+
     auto start_time = chrono::steady_clock::now();
 
     while (
@@ -135,7 +403,8 @@ CGResult column_generation(
 
         // Compute with a convex combination of the previous dual solution and the current one
         DualSolution convex_dual_solution = dual_solution;
-        if (parameters.use_stabilisation && iteration > 0){
+        bool is_smoothing = parameters.use_stabilisation && (iteration > 0 || has_stabilisation_center);
+        if (is_smoothing){
             convex_dual_solution = parameters.alpha * dual_solution + (1 - parameters.alpha) * previous_dual_solution;
         }
 
@@ -143,115 +412,100 @@ CGResult column_generation(
         // Get the remaining time to be set as the time limit for the Pathwyse heuristic
         int remaining_time_ms = S_TO_MS * parameters.time_limit - (master_time + pricing_time);
         double remaining_time = ((remaining_time_ms / 1000.0) / instance.number_vehicles) * std::thread::hardware_concurrency();
-        vector<Route> new_routes;
-        if (parameters.pricing_function == PRICING_PATHWYSE_BASIC){
-            Parameters::setParametersFromDict(pathwyse_parameters_dict(parameters, remaining_time, using_cyclic_pricing));
-            new_routes = full_pricing_problems_basic(
-                convex_dual_solution,
-                instance,
-                vehicle_order,
-                parameters.use_maximisation_formulation,
-                using_cyclic_pricing,
-                n_ressources_dominance
-            );
-        } else if (parameters.pricing_function == PRICING_DIVERSIFICATION){
-            Parameters::setParametersFromDict(pathwyse_parameters_dict(parameters, remaining_time, using_cyclic_pricing));
-            new_routes = full_pricing_problems_diversification(
-                convex_dual_solution,
-                instance,
-                vehicle_order,
-                parameters.use_maximisation_formulation,
-                using_cyclic_pricing,
-                n_ressources_dominance,
-                iteration
-            );
-        } else if (parameters.pricing_function == PRICING_CLUSTERING){
-            Parameters::setParametersFromDict(pathwyse_parameters_dict(parameters, remaining_time, using_cyclic_pricing));
-            new_routes = full_pricing_problems_clustering(
-                convex_dual_solution,
-                instance,
-                vehicle_order,
-                parameters.use_maximisation_formulation,
-                using_cyclic_pricing,
-                n_ressources_dominance,
-                iteration
-            );
-        } else if (parameters.pricing_function == PRICING_PA_BASIC){
-            new_routes = full_pricing_problems_basic_pulse(
-                convex_dual_solution,
-                instance,
-                vehicle_order,
-                parameters.use_maximisation_formulation,
-                parameters.delta,
-                parameters.solution_pool_size,
-                parameters.pricing_verbose
-            );
-        } else if (parameters.pricing_function == PRICING_PA_GROUPED){
-            auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
-            new_routes = full_pricing_problems_grouped_pulse(
-                convex_dual_solution,
-                instance,
-                vehicle_groups,
-                parameters.use_maximisation_formulation,
-                parameters.delta,
-                parameters.solution_pool_size,
-                parameters.pricing_verbose
-            );
-        } else if (parameters.pricing_function == PRICING_MPA) {
-            new_routes = full_pricing_problems_multithreaded_pulse(
-                convex_dual_solution,
-                instance,
-                vehicle_order,
-                parameters.use_maximisation_formulation,
-                parameters.delta,
-                parameters.solution_pool_size,
-                parameters.pricing_verbose
-            );
-        } else if (parameters.pricing_function == PRICING_MPA_GROUPED){
-            auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
-            new_routes = full_pricing_problems_grouped_pulse_multithreaded(
-                convex_dual_solution,
-                instance,
-                vehicle_groups,
-                parameters.use_maximisation_formulation,
-                parameters.delta,
-                parameters.solution_pool_size,
-                parameters.pricing_verbose
-            );
-        } else if (parameters.pricing_function == PRICING_MPA_GROUPED_PAR){
-            auto vehicle_groups = regroup_vehicles_by_depot(instance.vehicles);
-            new_routes = full_pricing_problems_grouped_pulse_par_par(
-                convex_dual_solution,
-                instance,
-                vehicle_groups,
-                parameters.use_maximisation_formulation,
-                parameters.delta,
-                parameters.solution_pool_size,
-                parameters.pricing_verbose
-            );
-        } else if (parameters.pricing_function == PRICING_PW_PA) {
-            // Begin by solving the Pathwyse heuristic
-            if (!using_cyclic_pricing){
-                new_routes = full_pricing_problems_basic(
-                    convex_dual_solution,
-                    instance,
+        SolverConfig pathwyse_config = pathwyse_solver_config(parameters, remaining_time, instance.capacities_labels.size(), using_cyclic_pricing);
+        // The pricing tiers are tried in order, until one of them finds an improving route
+        // The other pricing functions are solved once per round (tier -1)
+        bool use_pricing_tiers = is_pathwyse_pricing(parameters.pricing_function, using_cyclic_pricing);
+        int last_tier = pricing_tiers.size() - 1;
+        int tier;
+        // The heuristic tiers only get a share of the time left in the round, the last tier gets all of it
+        auto tier_time_limit = [&](int tier_index){
+            int round_time_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_pricing).count();
+            double time_left = ((std::max(remaining_time_ms - round_time_ms, 0) / 1000.0) / instance.number_vehicles) * std::thread::hardware_concurrency();
+            if (tier_index < last_tier){
+                time_left *= HEURISTIC_TIER_TIME_SHARE;
+            }
+            return std::max(time_left, MIN_TIER_TIME_LIMIT);
+        };
+        auto price_round = [&](const DualSolution& pricing_duals){
+            vector<Route> new_routes;
+            if (!use_pricing_tiers){
+                tier = -1;
+                new_routes = solve_pricing_round(
+                    pricing_instance,
+                    parameters,
+                    pricing_duals,
                     vehicle_order,
-                    parameters.use_maximisation_formulation,
                     using_cyclic_pricing,
-                    n_ressources_dominance
-                );
-            } else {
-                // Then, solve the PA
-                new_routes = full_pricing_problems_basic_pulse(
-                    convex_dual_solution,
-                    instance,
-                    vehicle_order,
-                    parameters.use_maximisation_formulation,
-                    parameters.delta,
-                    parameters.solution_pool_size,
-                    parameters.pricing_verbose
+                    n_ressources_dominance,
+                    pathwyse_config,
+                    pricing_groups,
+                    iteration,
+                    has_branching_cuts
                 );
+                // The tabu search moves do not follow the arcs of the pricing graphs (see below)
+                if (has_branching_cuts && parameters.pricing_function == PRICING_TABU_SEARCH){
+                    std::erase_if(new_routes, [&](const Route& new_route){
+                        return !respects_branching_cuts(new_route, node, instance);
+                    });
+                }
+                return new_routes;
+            }
+            for (tier = 0; tier <= last_tier; tier++){
+                // The tabu search tier does not depend on the pricing function
+                if (pricing_tiers[tier] == PRICING_TABU_SEARCH){
+                    new_routes = full_pricing_problems_tabu_search(
+                        pricing_duals,
+                        pricing_instance,
+                        vehicle_order,
+                        parameters.use_maximisation_formulation,
+                        parameters.tabu_iterations,
+                        parameters.tabu_tenure
+                    );
+                } else {
+                    pathwyse_config.main_algorithm_name = pricing_tiers[tier];
+                    pathwyse_config.timelimit = tier_time_limit(tier);
+                    new_routes = solve_pricing_round(
+                        pricing_instance,
+                        parameters,
+                        pricing_duals,
+                        vehicle_order,
+                        using_cyclic_pricing,
+                        n_ressources_dominance,
+                        pathwyse_config,
+                        pricing_groups,
+                        iteration,
+                        has_branching_cuts
+                    );
+                }
+                // The tabu search moves do not follow the arcs of the pricing graphs : its routes may not respect the
+                // branching decisions (the exact pricing algorithms only price on the restricted graphs)
+                if (has_branching_cuts && pricing_tiers[tier] == PRICING_TABU_SEARCH){
+                    std::erase_if(new_routes, [&](const Route& new_route){
+                        return !respects_branching_cuts(new_route, node, instance);
+                    });
+                }
+                if (tier == last_tier || has_improving_route(new_routes, parameters)){
+                    break;
+                }
             }
+            return new_routes;
+        };
+        vector<Route> new_routes = price_round(convex_dual_solution);
+        // Mispricing check : the routes found at the smoothed duals are re-priced at the current duals
+        // If none of them would improve the master problem, the round is solved again at the current duals
+        if (is_smoothing){
+            ColumnPool new_columns = build_column_pool(new_routes, instance, parameters.use_maximisation_formulation);
+            vector<double> reduced_costs = compute_reduced_costs(new_columns, dual_solution);
+            if (improving_columns(new_columns, reduced_costs, parameters.reduced_cost_threshold).empty()){
+                n_mispricings++;
+                new_routes = price_round(dual_solution);
+            }
+        }
+        if (tier >= 0){
+            pricing_tiers_usage[tier]++;
+        } else {
+            untiered_pricing_rounds++;
         }
         auto end_pricing = chrono::steady_clock::now();
         int diff_pricing = chrono::duration_cast<chrono::milliseconds>(end_pricing - start_pricing).count();
@@ -266,6 +520,8 @@ CGResult column_generation(
                     max_reduced_cost = std::max(max_reduced_cost, new_route.reduced_cost);
                     if (new_route.reduced_cost > parameters.reduced_cost_threshold){
                         add_route(model, new_route, instance, route_vars, intervention_ctrs, vehicle_ctrs, true);
+                        add_route_to_subset_row_cuts(model, new_route, route_vars.back(), subset_row_ctrs, subset_row_memories);
+                        add_route_to_branching_rows(model, new_route, route_vars.back(), branching_ctrs);
                         n_added_routes++;
                         routes.push_back(new_route);
 
@@ -276,6 +532,7 @@ CGResult column_generation(
                     min_reduced_cost = std::min(min_reduced_cost, new_route.reduced_cost);
                     if (new_route.reduced_cost < - parameters.reduced_cost_threshold){
                         add_route(model, new_route, instance, route_vars, intervention_ctrs, vehicle_ctrs, false);
+                        add_route_to_branching_rows(model, new_route, route_vars.back(), branching_ctrs);
                         n_added_routes++;
                         routes.push_back(new_route);
                     }
@@ -285,6 +542,9 @@ CGResult column_generation(
 
         if (parameters.verbose) {
             cout << "Pricing sub problems solved in " << diff_pricing << " ms - Added " << n_added_routes << " routes";
+            if (tier >= 0){
+                cout << " - Tier : " << pricing_tiers[tier];
+            }
             if (parameters.use_maximisation_formulation) {
                 cout << " - Max RC : " << setprecision(8) << max_reduced_cost << "\n";
             } else {
@@ -296,26 +556,28 @@ CGResult column_generation(
         // Solve the master problem
         auto start = chrono::steady_clock::now();
         int status = solve_model(model);
-        solution = extract_solution(model, route_vars, intervention_ctrs, vehicle_ctrs);
+        solution = extract_solution(model, route_vars, intervention_ctrs, vehicle_ctrs, subset_row_ctrs, branching_ctrs, subset_row_memories);
         auto end = chrono::steady_clock::now();
         int diff = chrono::duration_cast<chrono::milliseconds>(end - start).count();
         // At this point, if the solution is not feasible, it it because the cuts give a non feasible problem
-        // We can stop the algorithm
+        // We can stop the algorithm, without waiting for the time limit of the background integer solve
         if (!solution.is_feasible){
+            stop_intermediary_integer_model(integer_solve);
             return CGResult{};
         }
         // Extract the dual solution from the master solution
         DualSolution& dual_solution = solution.dual_solution;
 
         // Every five iterations, we compute an integer solution
-        if (parameters.compute_intermediate_integer_solutions && iteration % 5 == 0 && iteration > 0){
-            cout << "Solving intermediary integer model at iteration " << iteration << endl;
-            intermediary_integer_solution = solve_intermediary_integer_model(model, route_vars, postpone_vars, parameters.time_limit);
-
-            intermediary_integer_routes = routes;
-            if (!parameters.use_maximisation_formulation){
-                // Repair the integer solution
-                repair_routes(intermediary_integer_routes, intermediary_integer_solution, instance);
+        // It is solved in a background thread on a snapshot of the master problem, and published once available
+        if (parameters.compute_intermediate_integer_solutions){
+            if (integer_solve.valid() && integer_solve.solution.wait_for(chrono::seconds(0)) == std::future_status::ready){
+                publish_integer_solution(integer_solve.solution.get());
+            }
+            if (iteration % 5 == 0 && iteration > 0 && !integer_solve.valid()){
+                cout << "Solving intermediary integer model at iteration " << iteration << endl;
+                double remaining_time = parameters.time_limit - (master_time + pricing_time) / 1000.0;
+                integer_solve = launch_intermediary_integer_model(model, route_vars, postpone_vars, std::max(remaining_time, 1.));
             }
         }
     
@@ -351,6 +613,8 @@ CGResult column_generation(
         if (std::find(PA_VARIATIONS.begin(), PA_VARIATIONS.end(), parameters.pricing_function) == PA_VARIATIONS.end()){
             if (n_added_routes == 0 && parameters.switch_to_cyclic_pricing && !using_cyclic_pricing){
                 using_cyclic_pricing = true;
+                // The pricing problems are rebuilt on the cyclic graph
+                pricing_groups.clear();
                 // Reset the number of resources used for the dominance test
                 n_ressources_dominance = 0;
                 if (parameters.verbose){
@@ -375,6 +639,37 @@ CGResult column_generation(
                 continue;
             }
         }
+        // If no route was added, the subset row cuts violated by the solution are added before stopping
+        // The column generation then goes on with their duals
+        if (n_added_routes == 0 && use_subset_row_cuts && n_separation_rounds < parameters.max_subset_row_rounds){
+            n_separation_rounds++;
+            vector<SubsetRowCut> cuts = separate_subset_row_cuts(
+                solution,
+                routes,
+                instance,
+                parameters.max_subset_row_cuts,
+                subset_row_memories,
+                parameters.use_limited_memory_subset_row_cuts
+            );
+            if (!cuts.empty()){
+                auto start_separation = chrono::steady_clock::now();
+                for (const SubsetRowCut& cut : cuts){
+                    add_subset_row_cut(model, cut, subset_row_memories.at(cut), routes, route_vars, subset_row_ctrs);
+                }
+                solve_model(model);
+                solution = extract_solution(model, route_vars, intervention_ctrs, vehicle_ctrs, subset_row_ctrs, branching_ctrs, subset_row_memories);
+                master_time += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_separation).count();
+                if (parameters.verbose){
+                    cout << "-----------------------------------" << endl;
+                    cout << "Added " << cuts.size() << " subset row cuts - Objective value : " << solution.objective_value << endl;
+                }
+                consecutive_non_improvement = 0;
+                previous_solution_objective = solution.objective_value;
+                previous_dual_solution = solution.dual_solution;
+                iteration++;
+                continue;
+            }
+        }
         // If no route was added, we stop the algorithm
         if (n_added_routes == 0){
             stop = true;
@@ -394,6 +689,14 @@ CGResult column_generation(
         iteration++;
     }
 
+    // The last integer solve is awaited, and its solution replaces the last point of the integer tracking
+    if (integer_solve.valid()){
+        publish_integer_solution(integer_solve.solution.get());
+        integer_objective_values.back() = intermediary_integer_solution.objective_value;
+        integer_covered_interventions.back() = count_covered_interventions(intermediary_integer_solution, intermediary_integer_routes, instance);
+        integer_solution_costs.back() = integer_solution_cost(intermediary_integer_solution, intermediary_integer_routes);
+    }
+
     cout << "-----------------------------------" << endl;
     if (stop) {
         cout << "Found no new route to add" << endl;
@@ -405,11 +708,27 @@ CGResult column_generation(
         cout << "Time limit reached" << endl;
     }
     cout << "End of the column generation after " << iteration << " iterations" << endl;
-    // Convert the value from the minimum formulation to the maximum formulation
-    double total_outsource_cost = 0;
-    for (int i = 0; i < instance.number_interventions; i++){
-        total_outsource_cost += instance.nodes[i].duration * instance.M;
+    cout << "Pricing tiers usage :";
+    for (int t = 0; t < pricing_tiers.size(); t++){
+        cout << " " << pricing_tiers[t] << " (" << pricing_tiers_usage[t] << ")";
+    }
+    cout << " - Rounds without tiers : " << untiered_pricing_rounds << endl;
+    if (parameters.use_stabilisation){
+        cout << "Mispricings : " << n_mispricings << endl;
+    }
+    if (use_subset_row_cuts){
+        cout << "Subset row cuts : " << subset_row_ctrs.size() << " in " << n_separation_rounds << " separation rounds" << endl;
     }
+    // A row x_ijv >= 1 still relying on its artificial variable can not be satisfied : the node is infeasible
+    for (GRBVar& artificial_var : artificial_vars){
+        if (artificial_var.get(GRB_DoubleAttr_X) > 1e-6){
+            cout << "A required arc of the node can not be used - the node is infeasible" << endl;
+            return CGResult{};
+        }
+        // The artificial variables are all at 0 : they are kept out of the integer model
+        artificial_var.set(GRB_DoubleAttr_UB, 0.0);
+    }
+    // Convert the value from the minimum formulation to the maximum formulation
     double relaxed_maximum_objective;
     double relaxed_minimum_objective;
     if (parameters.use_maximisation_formulation){
@@ -424,8 +743,8 @@ CGResult column_generation(
 
 
 
-    // Update the node's upper bound
-    node.upper_bound = solution.objective_value;
+    // Update the node's upper bound (in the maximisation formulation, like the lower bound given by the branch and price)
+    node.upper_bound = relaxed_maximum_objective;
     // If the upper bound is lower than the lower bound, it isn't worth computing the integer solution
     bool compute_integer_solution = parameters.compute_integer_solution;
     if (node.upper_bound < node.lower_bound){
@@ -473,7 +792,10 @@ CGResult column_generation(
         integer_solution_costs,
         covered_interventions,
         integer_covered_interventions,
-        time_points
+        time_points,
+        pricing_tiers,
+        pricing_tiers_usage,
+        untiered_pricing_rounds
     };
 
     return result;
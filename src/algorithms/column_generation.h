@@ -10,6 +10,7 @@
 #include "algorithms/parameters.h"
 
 #include <vector>
+#include <string>
 
 struct CGResult {
     MasterSolution master_solution;
@@ -25,6 +26,11 @@ struct CGResult {
     std::vector<double> covered_interventions;
     std::vector<int> integer_covered_interventions;
     std::vector<int> time_points;
+    // Pricing tiers, with the number of pricing rounds that ended on each of them
+    std::vector<std::string> pricing_tiers;
+    std::vector<int> pricing_tiers_usage;
+    // Pricing rounds solved by a pricing function that does not use the tiers
+    int untiered_pricing_rounds = 0;
 };
 
 /*
@@ -41,7 +47,7 @@ struct CGResult {
 
     @param instance: The instance of the problem to solve
     @param node: The root node of the branch and price tree
-    @param initial_routes: The initial routes to use in the column generation algorithm
+    @param initial_routes: The initial routes to use in the column generation algorithm, the routes that the vehicles of the instance can not do are kept out of the master problem
 
     @param max_resources_dominance: The maximum number of resources to use in the dominance test
     @param switch_to_cyclic_pricing: Whether to switch to cyclic pricing when no new routes are added
@@ -50,11 +56,15 @@ struct CGResult {
     @param reduced_cost_threshold: The reduced cost threshold to stop the column generation algorithm
     @param verbose: Whether to print information about the column generation algorithm
 
+    @param initial_dual_solution: Center of the stabilisation for the first iteration (e.g. the duals of a previous day)
+    ignored if empty or if its size does not match the instance
+
     Returns a CGResult object containing the results of the column generation algorithm.
 */
 CGResult column_generation(
     const Instance & instance,
     BPNode & node,
     std::vector<Route> & routes,
-    const ColumnGenerationParameters & parameters
+    const ColumnGenerationParameters & parameters,
+    const DualSolution & initial_dual_solution = DualSolution()
     );
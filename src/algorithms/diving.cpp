@@ -0,0 +1,207 @@
+#include "diving.h"
+
+#include "algorithms/column_generation.h"
+
+#include "master_problem/master_solver.h"
+#include "master_problem/node.h"
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <iostream>
+
+
+void update_residual_instance(
+    Instance& residual,
+    const Instance& instance,
+    const std::vector<int>& covered_interventions,
+    const std::vector<int>& used_vehicles
+){
+    for (const Vehicle& vehicle : instance.vehicles){
+        Vehicle& residual_vehicle = residual.vehicles[vehicle.id];
+        if (used_vehicles[vehicle.id]){
+            set_vehicle_interventions(residual_vehicle, {}, vehicle.reverse_interventions.size());
+        } else {
+            residual_vehicle = vehicle_mask(vehicle, covered_interventions, KEEP_NON_COVERED);
+        }
+    }
+}
+
+
+// Routes with a positive value in a relaxed solution, by decreasing value (empty routes are never fixed)
+std::vector<int> diving_candidates(const std::vector<double>& coefficients, const std::vector<Route>& routes){
+    std::vector<int> candidates;
+    for (int r = 0; r < coefficients.size(); r++){
+        if (coefficients[r] > DIVING_MIN_VALUE && routes[r].id_sequence.size() > 2){
+            candidates.push_back(r);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [&coefficients](int r1, int r2) {return coefficients[r1] > coefficients[r2];});
+    return candidates;
+}
+
+
+// Value of a route in the objective of the master problem
+double route_value(const Route& route, const Instance& instance, bool use_maximisation_formulation){
+    if (use_maximisation_formulation){
+        return instance.M * route.total_duration - route.total_cost;
+    }
+    return route.total_cost;
+}
+
+
+IntegerSolution diving_heuristic(
+    const Instance& instance,
+    std::vector<Route>& routes,
+    const MasterSolution& root_solution,
+    const ColumnGenerationParameters& parameters
+){
+    using std::vector;
+    using std::cout, std::endl;
+    namespace chrono = std::chrono;
+
+    auto start = chrono::steady_clock::now();
+    bool use_max = parameters.use_maximisation_formulation;
+    // a is better than b
+    auto is_better = [use_max](double a, double b){
+        return use_max ? a > b + 1e-6 : a < b - 1e-6;
+    };
+
+    // Only a few iterations of column generation at each level, without integer solve
+    ColumnGenerationParameters level_parameters = parameters;
+    level_parameters.max_iterations = parameters.diving_iterations;
+    level_parameters.compute_integer_solution = false;
+    level_parameters.compute_intermediate_integer_solutions = false;
+    level_parameters.verbose = false;
+
+    // Current partial solution : fixed routes (one per level), covered interventions and used vehicles
+    vector<int> fixed_routes;
+    vector<int> covered_interventions(instance.nodes.size(), 0);
+    vector<int> used_vehicles(instance.vehicles.size(), 0);
+    double fixed_value = 0;
+    // Value of the postponed interventions in the minimisation formulation
+    double postponed_value = 0;
+    for (int i = 0; i < instance.number_interventions; i++){
+        postponed_value += instance.nodes[i].duration * instance.M;
+    }
+    auto fix_route = [&](int r, int value){
+        for (int k = 1; k + 1 < routes[r].id_sequence.size(); k++){
+            int intervention = routes[r].id_sequence[k];
+            covered_interventions[intervention] = value;
+            postponed_value += (value ? -1 : 1) * instance.nodes[intervention].duration * instance.M;
+        }
+        used_vehicles[routes[r].vehicle_id] = value;
+        fixed_value += (value ? 1 : -1) * route_value(routes[r], instance, use_max);
+        if (value){
+            fixed_routes.push_back(r);
+        } else {
+            fixed_routes.pop_back();
+        }
+    };
+    // Value of the partial solution, as an integer solution
+    auto partial_value = [&](){
+        return use_max ? fixed_value : fixed_value + postponed_value;
+    };
+
+    // Best solution found, as a set of fixed routes
+    vector<int> best_routes;
+    double best_value = 0;
+    bool has_solution = false;
+    auto record = [&](){
+        if (!has_solution || is_better(partial_value(), best_value)){
+            has_solution = true;
+            best_value = partial_value();
+            best_routes = fixed_routes;
+        }
+    };
+
+    // Residual instance of the partial solution, copied once and updated at each level
+    Instance residual = instance;
+
+    // Runs the column generation on the residual instance of the partial solution
+    // Returns the candidates of the next level, or false if the level must be pruned
+    auto solve_level = [&](vector<int>& candidates){
+        if (std::all_of(used_vehicles.begin(), used_vehicles.end(), [](int used){return used;})){
+            return true;
+        }
+        update_residual_instance(residual, instance, covered_interventions, used_vehicles);
+        // The level only gets the time left
+        int elapsed_time = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count();
+        level_parameters.time_limit = std::max(parameters.time_limit - elapsed_time, 1);
+
+        BPNode node = RootNode(routes);
+        node.lower_bound = - std::numeric_limits<double>::infinity();
+        CGResult result = column_generation(residual, node, routes, level_parameters);
+        if (!result.master_solution.is_feasible){
+            return false;
+        }
+        // In the minimisation formulation, the fixed interventions are postponed in the residual master problem
+        double estimate = fixed_value + result.master_solution.objective_value;
+        if (!use_max){
+            for (int i = 0; i < instance.number_interventions; i++){
+                estimate -= covered_interventions[i] * instance.nodes[i].duration * instance.M;
+            }
+        }
+        if (has_solution && !is_better(estimate, best_value)){
+            return false;
+        }
+        candidates = diving_candidates(result.master_solution.coefficients, routes);
+        return true;
+    };
+
+    // Each level of the dive keeps its candidates (by decreasing value), and the next one to try
+    struct DivingLevel {
+        vector<int> candidates;
+        int next = 0;
+    };
+    vector<DivingLevel> levels = {DivingLevel{diving_candidates(root_solution.coefficients, routes)}};
+    record();
+    int backtracks = 0;
+    int max_depth = 0;
+    while (!levels.empty()){
+        if (chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count() >= parameters.time_limit){
+            break;
+        }
+        DivingLevel& level = levels.back();
+        // All the routes of the level were tried : go back to the previous level
+        if (level.next == level.candidates.size()){
+            levels.pop_back();
+            if (!levels.empty()){
+                fix_route(fixed_routes.back(), 0);
+            }
+            continue;
+        }
+        // Trying another route of the level is a backtrack
+        if (level.next > 0){
+            if (backtracks == parameters.diving_max_backtracks){
+                break;
+            }
+            backtracks++;
+        }
+        int r = level.candidates[level.next++];
+        fix_route(r, 1);
+        record();
+        DivingLevel next_level;
+        if (solve_level(next_level.candidates)){
+            levels.push_back(next_level);
+            max_depth = std::max(max_depth, (int) fixed_routes.size());
+        } else {
+            fix_route(r, 0);
+        }
+    }
+
+    IntegerSolution solution = IntegerSolution(vector<int>(routes.size(), 0), best_value);
+    for (int r : best_routes){
+        solution.coefficients[r] = 1;
+    }
+    solution.objective_value = compute_integer_objective(solution, routes, instance, !use_max);
+    if (parameters.verbose){
+        int elapsed_time = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        cout << "-----------------------------------" << endl;
+        cout << "Diving heuristic : " << best_routes.size() << " routes fixed - Objective value : " << solution.objective_value;
+        cout << " - Maximum depth : " << max_depth << " - Backtracks : " << backtracks << " - Time : " << elapsed_time << " ms" << endl;
+    }
+    return solution;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "master_problem/master.h"
+#include "routes/route.h"
+
+#include "algorithms/parameters.h"
+
+#include <vector>
+
+// Minimum value of a route in the relaxed master solution for it to be fixed by the diving heuristic
+inline constexpr double DIVING_MIN_VALUE = 1e-6;
+
+
+// Restricts the vehicles of a residual instance (a copy of the instance, with the same nodes and vehicles) to the part of the
+// instance left free by a partial solution : the covered interventions are removed from the vehicles, and the used vehicles
+// have no intervention left (both are given as 0 / 1 masks)
+// Only the interventions of the vehicles change, so the same copy is updated at every level of the dive
+void update_residual_instance(
+    Instance& residual,
+    const Instance& instance,
+    const std::vector<int>& covered_interventions,
+    const std::vector<int>& used_vehicles
+);
+
+
+// Price and branch diving heuristic, from the relaxed solution of the master problem over the routes
+// At each level, the route with the highest value is fixed to 1 : its interventions and its vehicle are removed from the
+// instance, and a few column generation iterations (diving_iterations) are run on the residual instance, within the time
+// left out of parameters.time_limit
+// The column generation works on the routes vector itself : the routes that cover a fixed intervention or use a fixed
+// vehicle can not be done in the residual instance, and are kept out of its master problem (see column_generation)
+// The next level dives on the new relaxed solution, until no route has a positive value
+// The dive backtracks (tries the next route of the level) when the residual master problem is infeasible, or when its
+// objective, added to the fixed routes, can not beat the best solution found (the column generation is not run
+// to optimality, so this is only an estimate), at most diving_max_backtracks times
+// The routes generated during the dive are added to the routes vector
+// Returns the best integer solution found, indexed by the routes vector
+IntegerSolution diving_heuristic(
+    const Instance& instance,
+    std::vector<Route>& routes,
+    const MasterSolution& root_solution,
+    const ColumnGenerationParameters& parameters
+);
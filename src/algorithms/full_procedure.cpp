@@ -12,27 +12,59 @@
 #include "repair/repair.h"
 
 #include "algorithms/column_generation.h"
+#include "algorithms/diving.h"
+#include "algorithms/heuristics.h"
+
+#include "compact_formulation/compact_solver.h"
+#include "compact_formulation/solution_converter.h"
 
 #include "data_analysis/analysis.h"
 #include "data_analysis/export.h"
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
-CGResult full_cg_procedure(const Instance & instance, std::vector<Route>& routes, const ColumnGenerationParameters& parameters) {
+CGResult full_cg_procedure(const Instance & instance, std::vector<Route>& routes, const ColumnGenerationParameters& parameters, const DualSolution & initial_dual_solution) {
     using std::vector, std::string;
     using std::cout, std::endl, std::setprecision;
     namespace chrono = std::chrono;
 
     auto procedure_start = chrono::steady_clock::now();
 
+    // Seed the routes and the first stabilisation center with the relaxation of the compact model
+    DualSolution first_center = initial_dual_solution;
+    if (parameters.use_compact_seed){
+        CompactRelaxation relaxation = sparse_relaxed_compact_solver(instance, parameters.compact_seed_time_limit, parameters.verbose);
+        if (relaxation.is_feasible){
+            vector<Route> seed_routes = decompose_compact_flow(instance, relaxation.solution);
+            routes.insert(routes.end(), seed_routes.begin(), seed_routes.end());
+            // The duals of the relaxation are given in the maximisation formulation
+            DualSolution& duals = relaxation.dual_solution;
+            if (!parameters.use_maximisation_formulation){
+                for (int i = 0; i < instance.number_interventions; i++){
+                    duals.alphas[i] = instance.M * instance.nodes[i].duration - duals.alphas[i];
+                }
+                for (double& beta : duals.betas){
+                    beta = - beta;
+                }
+            }
+            if (first_center.alphas.empty()){
+                first_center = duals;
+            }
+            cout << "Compact relaxation : objective " << relaxation.solution.objective_value;
+            cout << " - " << seed_routes.size() << " seed routes" << endl;
+        }
+    }
+
     // Create a root node for the algorithm
     BPNode root = RootNode(routes);
     CGResult result = column_generation(
         instance,
         root, 
         routes, 
-        parameters
+        parameters,
+        first_center
         );
 
     // Extract the results from the column generation algorithm
@@ -40,6 +72,22 @@ CGResult full_cg_procedure(const Instance & instance, std::vector<Route>& routes
     int pricing_time = result.pricing_time;
     int integer_time = result.integer_time;
 
+    // The diving heuristic replaces the integer solution of the restricted master problem when it is better
+    if (parameters.use_diving_heuristic && result.master_solution.is_feasible){
+        auto start_diving = chrono::steady_clock::now();
+        IntegerSolution diving_solution = diving_heuristic(instance, routes, result.master_solution, parameters);
+        integer_time += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_diving).count();
+        result.integer_time = integer_time;
+        // The integer solution of the column generation only covers the routes that existed before the dive
+        result.integer_solution.coefficients.resize(routes.size(), 0);
+        bool is_better = parameters.use_maximisation_formulation
+            ? diving_solution.objective_value > result.integer_solution.objective_value
+            : diving_solution.objective_value < result.integer_solution.objective_value;
+        if (!result.integer_solution.is_feasible || is_better){
+            result.integer_solution = diving_solution;
+        }
+    }
+
     // If the integer solution is not feasible, we can't do much
     if (!result.integer_solution.is_feasible){
         cout << "-----------------------------------" << endl;
@@ -74,4 +122,49 @@ CGResult full_cg_procedure(const Instance & instance, std::vector<Route>& routes
     cout << "-----------------------------------" << endl;
 
     return result;
-}
\ No newline at end of file
+}
+
+
+CompactSolution<int> warm_started_compact_procedure(const Instance & instance, const ColumnGenerationParameters & parameters, int compact_time_limit) {
+    using std::vector;
+    using std::cout, std::endl, std::setprecision;
+
+    // The initial routes are a feasible solution by themselves
+    vector<Route> heuristic_routes = initial_routes_heuristic(instance, parameters.verbose);
+    vector<Route> routes = {EmptyRoute(instance.nodes.size())};
+    routes.insert(routes.end(), heuristic_routes.begin(), heuristic_routes.end());
+
+    // The column generation needs an integer solution to warm start the compact model
+    ColumnGenerationParameters cg_parameters = parameters;
+    cg_parameters.compute_integer_solution = true;
+    CGResult result = full_cg_procedure(instance, routes, cg_parameters);
+
+    // The routes of the integer solution that would cover an intervention or use a vehicle twice are left out of the start
+    // (after repair, an intervention can still be covered twice when removing it would make a route infeasible)
+    vector<Route> start_routes = heuristic_routes;
+    if (result.integer_solution.is_feasible){
+        start_routes.clear();
+        vector<int> is_covered(instance.nodes.size(), 0);
+        vector<int> is_used(instance.vehicles.size(), 0);
+        for (int r = 0; r < result.integer_solution.coefficients.size(); r++){
+            const Route& route = routes[r];
+            if (result.integer_solution.coefficients[r] == 0 || route.id_sequence.size() <= 2 || is_used[route.vehicle_id]){
+                continue;
+            }
+            bool is_disjoint = std::none_of(route.id_sequence.begin() + 1, route.id_sequence.end() - 1, [&](int i){return is_covered[i];});
+            if (!is_disjoint){
+                continue;
+            }
+            for (int k = 1; k + 1 < route.id_sequence.size(); k++){
+                is_covered[route.id_sequence[k]] = 1;
+            }
+            is_used[route.vehicle_id] = 1;
+            start_routes.push_back(route);
+        }
+    }
+    cout << "-----------------------------------" << endl;
+    cout << "Warm starting the compact model with " << start_routes.size() << " routes" << endl;
+    CompactSolution<int> solution = compact_solver(instance, compact_time_limit, start_routes, WARM_START, parameters.verbose);
+    cout << "Objective value of the compact model : " << setprecision(15) << solution.objective_value << endl;
+    return solution;
+}
@@ -3,5 +3,27 @@
 #include "parameters.h"
 #include "column_generation.h"
 
+#include "compact_formulation/compact_solution.h"
 
-CGResult full_cg_procedure(const Instance & instance, std::vector<Route> & routes, const ColumnGenerationParameters & parameters);
\ No newline at end of file
+
+// Column generation from the root node, followed by the repair and the analysis of the integer solution
+// initial_dual_solution is passed to column_generation as the first stabilisation center
+// With use_compact_seed, the routes decomposed from the compact relaxation are added to the routes, and its duals are the
+// first stabilisation center when no initial_dual_solution is given
+CGResult full_cg_procedure(
+    const Instance & instance,
+    std::vector<Route> & routes,
+    const ColumnGenerationParameters & parameters,
+    const DualSolution & initial_dual_solution = DualSolution()
+);
+
+
+// Compact model warm started by the column generation
+// The column generation runs first (full_cg_procedure, with the time limit of the parameters), and the routes of its
+// integer solution are given as a MIP start to compact_solver (WARM_START), which then runs for compact_time_limit seconds
+// The routes of the initial heuristic are used instead if the column generation finds no integer solution
+CompactSolution<int> warm_started_compact_procedure(
+    const Instance & instance,
+    const ColumnGenerationParameters & parameters,
+    int compact_time_limit
+);
@@ -0,0 +1,256 @@
+#include "heuristics.h"
+
+#include "routes/route_evaluation.h"
+#include "instance/parallel.h"
+#include "instance/constants.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+
+// Best insertion of an intervention in a route
+struct Insertion {
+    // Added cost : travel cost, plus the cost of the vehicle if the route was empty
+    double cost = std::numeric_limits<double>::infinity();
+    // Added travel cost only
+    double travel_cost = std::numeric_limits<double>::infinity();
+    // Position of the intervention in the sequence of the schedule, -1 if it can not be inserted
+    int position = -1;
+};
+
+
+// Sequence of interventions with the depot of the vehicle at both ends
+std::vector<int> with_depot(const std::vector<int>& sequence, const Vehicle& vehicle) {
+    std::vector<int> full_sequence = {vehicle.depot};
+    full_sequence.insert(full_sequence.end(), sequence.begin(), sequence.end());
+    full_sequence.push_back(vehicle.depot);
+    return full_sequence;
+}
+
+
+bool is_sequence_feasible(const std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle) {
+    return schedule_route(with_depot(sequence, vehicle), instance, vehicle).is_feasible;
+}
+
+
+// Cheapest feasible insertion of an intervention in a route
+Insertion best_insertion(const RouteSchedule& route, int intervention, const Instance& instance, const Vehicle& vehicle) {
+    Insertion best;
+    double vehicle_cost = route.sequence.size() == 2 ? vehicle.cost : 0;
+    for (int position = 1; position < route.sequence.size(); position++) {
+        double travel_cost = instance.cost_per_km * insertion_distance(route, position, intervention, instance);
+        if (travel_cost + vehicle_cost >= best.cost) {
+            continue;
+        }
+        if (is_insertion_feasible(route, position, intervention, instance, vehicle)) {
+            best = Insertion{travel_cost + vehicle_cost, travel_cost, position};
+        }
+    }
+    return best;
+}
+
+
+// Regret insertion of the unassigned interventions into the routes (one per vehicle)
+void insert_interventions(std::vector<RouteSchedule>& routes, std::vector<int>& is_assigned, const Instance& instance) {
+    using std::vector;
+    int n_interventions = instance.number_interventions;
+    int n_vehicles = instance.vehicles.size();
+
+    // Best insertion of every unassigned intervention in every route, evaluated in parallel
+    vector<vector<Insertion>> insertions(n_interventions, vector<Insertion>(n_vehicles));
+    auto update_insertion = [&](int i, int v) {
+        const Vehicle& vehicle = instance.vehicles[v];
+        if (!is_assigned[i] && vehicle.reverse_interventions[i] >= 0) {
+            insertions[i][v] = best_insertion(routes[v], i, instance, vehicle);
+        } else {
+            insertions[i][v] = Insertion();
+        }
+    };
+    parallel_for(n_interventions, [&](int i) {
+        for (int v = 0; v < n_vehicles; v++) {
+            update_insertion(i, v);
+        }
+    });
+
+    while (true) {
+        // Find the intervention with the largest regret
+        int best_intervention = -1;
+        int best_vehicle = -1;
+        double best_regret = -std::numeric_limits<double>::infinity();
+        for (int i = 0; i < n_interventions; i++) {
+            if (is_assigned[i]) continue;
+            double first = std::numeric_limits<double>::infinity();
+            double second = std::numeric_limits<double>::infinity();
+            int first_vehicle = -1;
+            for (int v = 0; v < n_vehicles; v++) {
+                double cost = insertions[i][v].cost;
+                if (cost < first) {
+                    second = first;
+                    first = cost;
+                    first_vehicle = v;
+                } else if (cost < second) {
+                    second = cost;
+                }
+            }
+            // Only insert the interventions worth more than the travel they add
+            double value = instance.M * instance.nodes[i].duration;
+            if (first_vehicle == -1 || insertions[i][first_vehicle].travel_cost >= value) continue;
+            // Not covering the intervention is always an alternative
+            double regret = std::min(second, value) - first;
+            if (regret > best_regret) {
+                best_regret = regret;
+                best_intervention = i;
+                best_vehicle = first_vehicle;
+            }
+        }
+        if (best_intervention == -1) break;
+
+        // Insert it and update the route
+        RouteSchedule& route = routes[best_vehicle];
+        vector<int> sequence = route.sequence;
+        sequence.insert(sequence.begin() + insertions[best_intervention][best_vehicle].position, best_intervention);
+        route = schedule_route(sequence, instance, instance.vehicles[best_vehicle]);
+        is_assigned[best_intervention] = 1;
+
+        // Only the insertions in the modified route have changed
+        for (int i = 0; i < n_interventions; i++) {
+            update_insertion(i, best_vehicle);
+        }
+    }
+}
+
+
+// Builds the schedules of the routes from sequences of interventions (one per vehicle)
+std::vector<RouteSchedule> schedule_routes(const std::vector<std::vector<int>>& sequences, const Instance& instance) {
+    std::vector<RouteSchedule> routes(instance.vehicles.size());
+    for (int v = 0; v < instance.vehicles.size(); v++) {
+        routes[v] = schedule_route(with_depot(sequences[v], instance.vehicles[v]), instance, instance.vehicles[v]);
+    }
+    return routes;
+}
+
+
+// Sequence of interventions of a route, without the depot
+std::vector<int> interventions_sequence(const RouteSchedule& route) {
+    return std::vector<int>(route.sequence.begin() + 1, route.sequence.end() - 1);
+}
+
+
+std::vector<std::vector<int>> regret_insertion(const Instance& instance) {
+    std::vector<std::vector<int>> sequences(instance.vehicles.size());
+    std::vector<RouteSchedule> routes = schedule_routes(sequences, instance);
+    std::vector<int> is_assigned(instance.number_interventions, 0);
+    insert_interventions(routes, is_assigned, instance);
+    for (int v = 0; v < routes.size(); v++) {
+        sequences[v] = interventions_sequence(routes[v]);
+    }
+    return sequences;
+}
+
+
+// Total distance travelled along a sequence, from and back to the depot
+int sequence_distance(const std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle) {
+    int distance = 0;
+    int previous = vehicle.depot;
+    for (int i : sequence) {
+        distance += instance.distance_matrix[previous][i];
+        previous = i;
+    }
+    return distance + instance.distance_matrix[previous][vehicle.depot];
+}
+
+
+bool improve_sequence(std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle) {
+    using std::vector;
+    int n = sequence.size();
+    int best_distance = sequence_distance(sequence, instance, vehicle);
+    bool improved = false;
+    // Accepts the candidate if it is shorter and feasible
+    auto try_move = [&](const vector<int>& candidate) {
+        int distance = sequence_distance(candidate, instance, vehicle);
+        if (distance < best_distance && is_sequence_feasible(candidate, instance, vehicle)) {
+            sequence = candidate;
+            best_distance = distance;
+            return true;
+        }
+        return false;
+    };
+
+    for (int pass = 0; pass < MAX_LOCAL_SEARCH_PASSES; pass++) {
+        bool improved_pass = false;
+        // Relocate : move one intervention to another position
+        for (int i = 0; i < n && !improved_pass; i++) {
+            for (int j = 0; j < n && !improved_pass; j++) {
+                if (i == j) continue;
+                vector<int> candidate = sequence;
+                int intervention = candidate[i];
+                candidate.erase(candidate.begin() + i);
+                candidate.insert(candidate.begin() + j, intervention);
+                improved_pass = try_move(candidate);
+            }
+        }
+        // 2-opt : reverse a part of the sequence
+        for (int i = 0; i < n && !improved_pass; i++) {
+            for (int j = i + 2; j <= n && !improved_pass; j++) {
+                vector<int> candidate = sequence;
+                std::reverse(candidate.begin() + i, candidate.begin() + j);
+                improved_pass = try_move(candidate);
+            }
+        }
+        if (!improved_pass) break;
+        improved = true;
+    }
+    return improved;
+}
+
+
+std::vector<Route> initial_routes_heuristic(const Instance& instance, bool verbose) {
+    using std::vector;
+    using std::cout, std::endl;
+    auto start = std::chrono::steady_clock::now();
+
+    // Regret insertion, then a local search on every route
+    vector<vector<int>> sequences = regret_insertion(instance);
+    parallel_for(sequences.size(), [&](int v) {
+        improve_sequence(sequences[v], instance, instance.vehicles[v]);
+    });
+
+    // The shorter routes may leave room for some of the uncovered interventions
+    vector<RouteSchedule> routes = schedule_routes(sequences, instance);
+    vector<int> is_assigned(instance.number_interventions, 0);
+    for (const auto& sequence : sequences) {
+        for (int i : sequence) {
+            is_assigned[i] = 1;
+        }
+    }
+    insert_interventions(routes, is_assigned, instance);
+
+    // Convert the sequences to routes (in terms of in-vehicle indices, with the depot at both ends)
+    vector<Route> result;
+    int covered = 0;
+    double total_cost = 0;
+    for (int v = 0; v < routes.size(); v++) {
+        vector<int> interventions = interventions_sequence(routes[v]);
+        if (interventions.empty()) continue;
+        const Vehicle& vehicle = instance.vehicles[v];
+        vector<int> sequence = {-1};
+        for (int i : interventions) {
+            sequence.push_back(vehicle.reverse_interventions[i]);
+        }
+        sequence.push_back(-1);
+        result.push_back(convert_sequence_to_route(0, sequence, instance, vehicle));
+        covered += interventions.size();
+        total_cost += result.back().total_cost;
+    }
+
+    if (verbose) {
+        auto end = std::chrono::steady_clock::now();
+        int diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        cout << "Initial heuristic : " << result.size() << " routes covering " << covered << " / " << instance.number_interventions;
+        cout << " interventions, total cost " << total_cost << " (" << diff << " ms)" << endl;
+    }
+    return result;
+}
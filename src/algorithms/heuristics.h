@@ -0,0 +1,36 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "routes/route.h"
+
+#include <vector>
+
+// Maximum number of improving passes of the local search on a single route
+inline constexpr int MAX_LOCAL_SEARCH_PASSES = 20;
+
+
+// Checks the time windows (with the lunch break rule) and the capacities of a sequence of interventions done by a vehicle
+// The sequence contains the indices of the interventions in the nodes vector, without the depot
+// The vehicle leaves its depot at time 0 and must be back before END_DAY (see schedule_route)
+bool is_sequence_feasible(const std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle);
+
+
+// Builds one sequence of interventions per vehicle by parallel regret insertion
+// All the routes are built at the same time : at each step, the intervention with the largest regret
+// (loss between its best insertion and its best insertion in another vehicle, or leaving it uncovered) is inserted at its best position
+// An intervention is only inserted if its value (M * duration) is larger than the added travel cost
+// The sequences are indexed by vehicle, and contain the indices of the interventions in the nodes vector
+std::vector<std::vector<int>> regret_insertion(const Instance& instance);
+
+
+// Local search on a single sequence, reducing its travel distance with relocate and 2-opt moves
+// Only the moves keeping the sequence feasible (see is_sequence_feasible) are applied
+// Returns true if the sequence was improved
+bool improve_sequence(std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle);
+
+
+// Initial routes for the column generation : regret insertion, followed by a local search on each route
+// The interventions left uncovered are then inserted again in the improved routes
+// Returns one route per used vehicle, each intervention being covered at most once
+// so that selecting all the routes is a feasible integer solution of the master problem
+std::vector<Route> initial_routes_heuristic(const Instance& instance, bool verbose = false);
@@ -45,6 +45,20 @@ ColumnGenerationParameters::ColumnGenerationParameters(std::map<std::string, std
         pathwyse_TL = std::any_cast<double>(args["pathwyse_time_limit"]);
     if (args.contains("bidirectional_DP"))
         bidirectional_DP = std::any_cast<bool>(args["bidirectional_DP"]);
+    if (args.contains("use_resource_bounds"))
+        use_resource_bounds = std::any_cast<bool>(args["use_resource_bounds"]);
+    if (args.contains("use_completion_bounds"))
+        use_completion_bounds = std::any_cast<bool>(args["use_completion_bounds"]);
+    if (args.contains("completion_bounds_step"))
+        completion_bounds_step = std::any_cast<int>(args["completion_bounds_step"]);
+    if (args.contains("pricing_tiers"))
+        pricing_tiers = std::any_cast<std::vector<std::string>>(args["pricing_tiers"]);
+    if (args.contains("heuristic_queue_limit"))
+        heuristic_queue_limit = std::any_cast<int>(args["heuristic_queue_limit"]);
+    if (args.contains("tabu_iterations"))
+        tabu_iterations = std::any_cast<int>(args["tabu_iterations"]);
+    if (args.contains("tabu_tenure"))
+        tabu_tenure = std::any_cast<int>(args["tabu_tenure"]);
 
     // Pulse related parameters
     if (args.contains("delta")) {
@@ -62,6 +76,26 @@ ColumnGenerationParameters::ColumnGenerationParameters(std::map<std::string, std
         use_stabilisation = std::any_cast<bool>(args["use_stabilisation"]);
     }
 
+    // Diving heuristic
+    if (args.contains("use_diving_heuristic"))
+        use_diving_heuristic = std::any_cast<bool>(args["use_diving_heuristic"]);
+    if (args.contains("diving_iterations"))
+        diving_iterations = std::any_cast<int>(args["diving_iterations"]);
+    if (args.contains("diving_max_backtracks"))
+        diving_max_backtracks = std::any_cast<int>(args["diving_max_backtracks"]);
+    if (args.contains("use_compact_seed"))
+        use_compact_seed = std::any_cast<bool>(args["use_compact_seed"]);
+    if (args.contains("compact_seed_time_limit"))
+        compact_seed_time_limit = std::any_cast<int>(args["compact_seed_time_limit"]);
+    if (args.contains("use_subset_row_cuts"))
+        use_subset_row_cuts = std::any_cast<bool>(args["use_subset_row_cuts"]);
+    if (args.contains("max_subset_row_cuts"))
+        max_subset_row_cuts = std::any_cast<int>(args["max_subset_row_cuts"]);
+    if (args.contains("max_subset_row_rounds"))
+        max_subset_row_rounds = std::any_cast<int>(args["max_subset_row_rounds"]);
+    if (args.contains("use_limited_memory_subset_row_cuts"))
+        use_limited_memory_subset_row_cuts = std::any_cast<bool>(args["use_limited_memory_subset_row_cuts"]);
+
     // Pricing function
     if (args.contains("pricing_function")) {
         pricing_function = std::any_cast<std::string>(args["pricing_function"]);
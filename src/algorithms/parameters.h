@@ -3,6 +3,7 @@
 #include <map>
 #include <any>
 #include <string>
+#include <vector>
 
 #include "pricing_problem/full_pricing.h"
 #include "../../pathwyse/core/utils/param.h"
@@ -30,6 +31,20 @@ struct ColumnGenerationParameters {
     int dssr = DSSR_STANDARD;
     float pathwyse_TL = 0.0;
     bool bidirectional_DP = false;
+    // Prune the pricing graphs with resource bounds, computed once per pricing problem
+    bool use_resource_bounds = true;
+    // Prune the forward labels with lower bounds on their completion cost (relaxed backward DP over time buckets)
+    bool use_completion_bounds = true;
+    int completion_bounds_step = 10;
+    // Pathwyse algorithms tried in order at each pricing round, the next one is only used if no improving route is found
+    // The last one should be exact (PWDefault) for the stopping conditions to be valid
+    std::vector<std::string> pricing_tiers = {"PWDefaultRelaxQueue", "PWDefaultRelaxDom", "PWDefault"};
+    // Maximum number of candidate labels per node for PWDefaultRelaxQueue
+    int heuristic_queue_limit = 10;
+    // The tabu search pricing (PRICING_TABU_SEARCH) can also be used as a tier, typically the first one
+    // Number of iterations and tabu tenure of the tabu search of each vehicle
+    int tabu_iterations = 100;
+    int tabu_tenure = 10;
 
     // Pulse related parameters
     int delta = 10;
@@ -38,6 +53,25 @@ struct ColumnGenerationParameters {
     double alpha = 0.5;
     bool use_stabilisation = false;
 
+    // Diving heuristic (see diving.h), run after the column generation to get an integer solution
+    // Number of column generation iterations after each fixed route, and maximum number of backtracks
+    bool use_diving_heuristic = false;
+    int diving_iterations = 5;
+    int diving_max_backtracks = 10;
+
+    // Seeding from the linear relaxation of the sparse compact model (see sparse_relaxed_compact_solver)
+    // The decomposed arc flow gives the initial routes, and the duals the first stabilisation center
+    bool use_compact_seed = false;
+    int compact_seed_time_limit = 60;
+
+    // Subset row cuts over three interventions (see subset_row_cuts.h), maximisation formulation only
+    // Maximum number of cuts added by a separation round, and maximum number of rounds
+    bool use_subset_row_cuts = false;
+    int max_subset_row_cuts = 20;
+    int max_subset_row_rounds = 5;
+    // Limited memory of the cuts, restricted to the interventions needed by the routes of the relaxed solution
+    bool use_limited_memory_subset_row_cuts = false;
+
     // Pricing function
     std::string pricing_function = PRICING_PATHWYSE_BASIC;
     bool pricing_verbose = false;
@@ -0,0 +1,173 @@
+#include "rolling_horizon.h"
+
+#include "algorithms/full_procedure.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <algorithm>
+#include <iostream>
+
+
+// Key identifying a team : the sorted ids of its technicians
+std::string team_key(const Vehicle& vehicle){
+    std::vector<std::string> technicians = vehicle.technicians;
+    std::sort(technicians.begin(), technicians.end());
+    std::string key;
+    for (const std::string& technician : technicians){
+        key += technician + ";";
+    }
+    return key;
+}
+
+
+DayMapping map_days(const Instance& previous, const Instance& next){
+    using std::map, std::string;
+    DayMapping mapping;
+
+    map<string, int> next_interventions;
+    for (int i = 0; i < next.number_interventions; i++){
+        next_interventions[next.nodes[i].id] = i;
+    }
+    mapping.interventions.assign(previous.number_interventions, -1);
+    for (int i = 0; i < previous.number_interventions; i++){
+        auto it = next_interventions.find(previous.nodes[i].id);
+        if (it != next_interventions.end()){
+            mapping.interventions[i] = it->second;
+        }
+    }
+
+    map<string, int> next_vehicles;
+    for (const Vehicle& vehicle : next.vehicles){
+        next_vehicles[team_key(vehicle)] = vehicle.id;
+    }
+    mapping.vehicles.assign(previous.vehicles.size(), -1);
+    for (const Vehicle& vehicle : previous.vehicles){
+        auto it = next_vehicles.find(team_key(vehicle));
+        if (it != next_vehicles.end()){
+            mapping.vehicles[vehicle.id] = it->second;
+        }
+    }
+    return mapping;
+}
+
+
+std::vector<Route> carry_routes(
+    const std::vector<Route>& routes,
+    const Instance& next,
+    const DayMapping& mapping
+){
+    using std::vector;
+    vector<Route> carried;
+    std::set<std::pair<int, vector<int>>> seen;
+    for (const Route& route : routes){
+        // Empty routes are not tied to a vehicle
+        if (route.id_sequence.size() <= 2 || mapping.vehicles[route.vehicle_id] == -1){
+            continue;
+        }
+        const Vehicle& vehicle = next.vehicles[mapping.vehicles[route.vehicle_id]];
+        // The sequence in terms of in-vehicle indices, the depot being dropped at both ends
+        vector<int> sequence = {-1};
+        bool valid = true;
+        for (int k = 1; k < route.id_sequence.size() - 1 && valid; k++){
+            int i = mapping.interventions[route.id_sequence[k]];
+            valid = i != -1 && vehicle.reverse_interventions[i] != -1;
+            if (valid){
+                sequence.push_back(vehicle.reverse_interventions[i]);
+            }
+        }
+        sequence.push_back(-1);
+        if (!valid || !seen.insert({vehicle.id, sequence}).second){
+            continue;
+        }
+        Route new_route = convert_sequence_to_route(0, sequence, next, vehicle);
+        // The time windows, travel times and depot may have changed
+        if (is_route_feasible(new_route, next, false)){
+            carried.push_back(new_route);
+        }
+    }
+    return carried;
+}
+
+
+DualSolution carry_duals(
+    const DualSolution& duals,
+    const Instance& previous,
+    const Instance& next,
+    const DayMapping& mapping
+){
+    DualSolution next_duals;
+    if (duals.alphas.size() != previous.number_interventions || duals.betas.size() != previous.vehicles.size()){
+        return next_duals;
+    }
+
+    // Average dual value per minute of intervention, and per vehicle
+    double total_alpha = 0;
+    int total_duration = 0;
+    for (int i = 0; i < previous.number_interventions; i++){
+        total_alpha += duals.alphas[i];
+        total_duration += previous.nodes[i].duration;
+    }
+    double alpha_per_minute = total_duration > 0 ? total_alpha / total_duration : 0;
+    double total_beta = 0;
+    for (double beta : duals.betas){
+        total_beta += beta;
+    }
+    double average_beta = duals.betas.empty() ? 0 : total_beta / duals.betas.size();
+
+    next_duals.alphas.resize(next.number_interventions);
+    for (int i = 0; i < next.number_interventions; i++){
+        next_duals.alphas[i] = alpha_per_minute * next.nodes[i].duration;
+    }
+    for (int i = 0; i < previous.number_interventions; i++){
+        if (mapping.interventions[i] != -1){
+            next_duals.alphas[mapping.interventions[i]] = duals.alphas[i];
+        }
+    }
+    next_duals.betas.assign(next.vehicles.size(), average_beta);
+    for (int v = 0; v < previous.vehicles.size(); v++){
+        if (mapping.vehicles[v] != -1){
+            next_duals.betas[mapping.vehicles[v]] = duals.betas[v];
+        }
+    }
+    return next_duals;
+}
+
+
+std::vector<DayResult> rolling_horizon_procedure(
+    const std::vector<Instance>& days,
+    const ColumnGenerationParameters& parameters
+){
+    using std::vector;
+    using std::cout, std::endl;
+
+    vector<DayResult> results;
+    for (int d = 0; d < days.size(); d++){
+        const Instance& day = days[d];
+        cout << "-----------------------------------" << endl;
+        cout << "Day " << d << " : " << day.name << endl;
+
+        vector<Route> routes = {EmptyRoute(day.nodes.size())};
+        DualSolution initial_dual_solution;
+        int carried_routes = 0;
+        if (d > 0){
+            const Instance& previous = days[d - 1];
+            const DayResult& previous_result = results.back();
+            DayMapping mapping = map_days(previous, day);
+            vector<Route> carried = carry_routes(previous_result.routes, day, mapping);
+            carried_routes = carried.size();
+            routes.insert(routes.end(), carried.begin(), carried.end());
+            initial_dual_solution = carry_duals(previous_result.result.master_solution.dual_solution, previous, day, mapping);
+
+            int common_interventions = std::count_if(mapping.interventions.begin(), mapping.interventions.end(), [](int i){return i != -1;});
+            int common_vehicles = std::count_if(mapping.vehicles.begin(), mapping.vehicles.end(), [](int v){return v != -1;});
+            cout << "Interventions carried over : " << common_interventions << " - Vehicles carried over : " << common_vehicles;
+            cout << " - Routes carried over : " << carried_routes << endl;
+        }
+
+        CGResult result = full_cg_procedure(day, routes, parameters, initial_dual_solution);
+        cout << "Day " << d << " solved in " << result.number_of_iterations << " iterations" << endl;
+        results.push_back(DayResult{result, routes, carried_routes});
+    }
+    return results;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "master_problem/master.h"
+#include "routes/route.h"
+
+#include "algorithms/parameters.h"
+#include "algorithms/column_generation.h"
+
+#include <vector>
+
+
+// Correspondence between the interventions and the vehicles of two consecutive days
+// Interventions are matched on their id (Node::id), vehicles on the ids of the technicians of their team
+struct DayMapping {
+    // Index in the next day of each intervention of the previous day (-1 if it is not planned on the next day)
+    std::vector<int> interventions;
+    // Index in the next day of each vehicle of the previous day (-1 if the team does not exist on the next day)
+    std::vector<int> vehicles;
+};
+
+// Result of the column generation on one day of a rolling horizon
+struct DayResult {
+    CGResult result;
+    // Columns of the day (including the ones carried over from the previous day)
+    std::vector<Route> routes;
+    // Number of routes of the previous day used as initial columns
+    int carried_routes;
+};
+
+
+// Builds the correspondence between the interventions and vehicles of two days
+DayMapping map_days(const Instance& previous, const Instance& next);
+
+
+// Translates the routes of the previous day into routes of the next day
+// Only the routes whose vehicle and interventions all exist on the next day, and that are still feasible, are kept
+// Duplicates and empty routes are removed
+std::vector<Route> carry_routes(
+    const std::vector<Route>& routes,
+    const Instance& next,
+    const DayMapping& mapping
+);
+
+
+// Translates the dual solution of the previous day into an estimate for the next day
+// The interventions and vehicles that are new get the average dual value (per minute of intervention for the interventions)
+// Returns an empty dual solution if the previous one is empty
+DualSolution carry_duals(
+    const DualSolution& duals,
+    const Instance& previous,
+    const Instance& next,
+    const DayMapping& mapping
+);
+
+
+// Solves a sequence of days with the full column generation procedure
+// Each day starts from the feasible routes of the previous day, and uses its duals as the first stabilisation center
+// The instances must be preprocessed
+std::vector<DayResult> rolling_horizon_procedure(
+    const std::vector<Instance>& days,
+    const ColumnGenerationParameters& parameters
+);
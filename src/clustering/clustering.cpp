@@ -4,47 +4,38 @@
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <bit>
+
+#include "instance/parallel.h"
 
 #include "gurobi_c++.h"
 
 
 int hamming_distance(const Vehicle& vehicle1, const Vehicle& vehicle2){
-    using std::map;
-
-    map<int, int> interventions;
-    // Store the interventions of each vehicle in a map
-    for (int intervention : vehicle1.interventions){
-        interventions[intervention] += 1;
-    }
-    for (int intervention : vehicle2.interventions){
-        interventions[intervention] += 1;
-    }
-    // Those that have a value of 1 are only in one of the vehicles - they contribute 1 to the distance
+    // The interventions only in one of the vehicles are the bits set in the xor of the bitsets
     int distance = 0;
-    for (auto [intervention, count] : interventions){
-        if (count == 1){
-            distance += 1;
-        }
+    for (int w = 0; w < vehicle1.interventions_bits.size(); w++){
+        distance += std::popcount(vehicle1.interventions_bits[w] ^ vehicle2.interventions_bits[w]);
     }
-
     return distance;
 }
 
 
-std::vector<std::vector<int>> compute_similarity_matrix(const std::vector<Vehicle>& vehicles){
+DenseMatrix<int> compute_similarity_matrix(const std::vector<Vehicle>& vehicles){
     int n = vehicles.size();
-    std::vector<std::vector<int>> matrix(n, std::vector<int>(n, 0));
-    for (int i = 0; i < n; i++){
+    DenseMatrix<int> matrix(n, n, 0);
+    // Row i fills the entries (i, j) and (j, i) for j > i, so no entry is written by two threads
+    parallel_for(n, [&](int i){
         for (int j = i + 1; j < n; j++){
             matrix[i][j] = hamming_distance(vehicles[i], vehicles[j]);
             matrix[j][i] = matrix[i][j];
         }
-    }
+    });
     return matrix;
 }
 
 
-std::vector<std::vector<int>> optimal_clustering_by_2(std::vector<std::vector<int>> similarity_matrix){
+std::vector<std::vector<int>> optimal_clustering_by_2(const DenseMatrix<int>& similarity_matrix){
 
     using std::vector;
     int n = similarity_matrix.size();
@@ -117,7 +108,7 @@ std::vector<std::vector<int>> optimal_clustering_by_2(std::vector<std::vector<in
     return clusters;
 }
 
-std::vector<std::vector<int>> optimal_2_clustering(std::vector<std::vector<int>> similarity_matrix){
+std::vector<std::vector<int>> optimal_2_clustering(const DenseMatrix<int>& similarity_matrix){
     using std::vector;
     int n = similarity_matrix.size();
     
@@ -168,7 +159,7 @@ std::vector<std::vector<int>> optimal_2_clustering(std::vector<std::vector<int>>
 
 
 std::vector<std::vector<int>> greedy_neighbor(
-    const std::vector<std::vector<int>>& similarity_matrix, 
+    const DenseMatrix<int>& similarity_matrix, 
     const std::vector<std::vector<int>>& initial_clusters,
     int seed 
     ){
@@ -226,7 +217,7 @@ std::vector<std::vector<int>> greedy_neighbor(
 
 int compute_clustering_cost(
     const std::vector<std::vector<int>>& clusters,
-    const std::vector<std::vector<int>>& similarity_matrix
+    const DenseMatrix<int>& similarity_matrix
 ){
     int cost = 0;
     for (const auto& cluster : clusters){
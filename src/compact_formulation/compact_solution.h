@@ -14,13 +14,15 @@ struct CompactSolution{
     std::vector<std::vector<std::vector<T>>> x;
     std::vector<T> y;
     std::vector<int> u;
+    // Whether each intervention is done in the afternoon (only relevant for the ambiguous ones)
+    std::vector<int> z;
 
     // Default constructor
-    CompactSolution() : objective_value(0.0), x(), y(), u() {}
+    CompactSolution() : objective_value(0.0), x(), y(), u(), z() {}
 
     // Constructor with sizes
     CompactSolution(int n_nodes, int n_interventions, int n_vehicles) : 
-        objective_value(0.0), x(n_nodes, std::vector<std::vector<T>>(n_nodes, std::vector<T>(n_vehicles))), y(n_vehicles), u(n_interventions) {}
+        objective_value(0.0), x(n_nodes, std::vector<std::vector<T>>(n_nodes, std::vector<T>(n_vehicles))), y(n_vehicles), u(n_interventions), z(n_interventions) {}
 };
 
 
@@ -4,11 +4,168 @@
 #include <string>
 #include "gurobi_c++.h"
 #include "instance/constants.h"
+#include "instance/preprocessing.h"
+#include "compact_formulation/solution_converter.h"
 
+#include <map>
+#include <tuple>
+#include <cmath>
+#include <algorithm>
+
+
+
+std::vector<CompactArc> compact_arcs(const Instance& instance) {
+    using std::vector;
+    vector<CompactArc> arcs;
+    for (const Vehicle& vehicle : instance.vehicles) {
+        int depot = vehicle.depot;
+        for (int i : vehicle.interventions) {
+            const Node& node_i = instance.nodes[i];
+            // The intervention must fit in its time window when leaving the depot at time 0, and allow to go back before the end of the day
+            int start = earliest_start(node_i, instance.time_matrix[depot][i]);
+            if (start + node_i.duration > node_i.end_window || start + node_i.duration + instance.time_matrix[i][depot] > END_DAY) {
+                continue;
+            }
+            arcs.push_back({depot, i, vehicle.id});
+            arcs.push_back({i, depot, vehicle.id});
+            for (int j : vehicle.interventions) {
+                if (i != j && is_edge_feasible(i, j, instance)) {
+                    arcs.push_back({i, j, vehicle.id});
+                }
+            }
+        }
+    }
+    // The arcs towards the interventions that can not be reached from the depot are removed
+    vector<int> is_reachable(instance.nodes.size() * instance.vehicles.size(), 0);
+    for (const CompactArc& arc : arcs) {
+        if (arc.from >= instance.number_interventions) {
+            is_reachable[arc.to * instance.vehicles.size() + arc.vehicle] = 1;
+        }
+    }
+    std::erase_if(arcs, [&](const CompactArc& arc) {
+        return arc.to < instance.number_interventions && !is_reachable[arc.to * instance.vehicles.size() + arc.vehicle];
+    });
+    return arcs;
+}
+
+
+// Lazy constraints of the sparse compact model : travel times along the arcs, and lunch break
+// They are only added when an integer solution violates them
+class CompactLazyConstraints : public GRBCallback {
+public:
+    // Number of lazy constraints added
+    int n_added = 0;
+
+    CompactLazyConstraints(
+        const Instance& instance,
+        const std::vector<CompactArc>& arcs,
+        const std::vector<GRBVar>& x,
+        const std::vector<GRBVar>& u,
+        const std::vector<GRBVar>& z
+    ) : instance(instance), arcs(arcs), x(x), u(u), z(z) {
+        // The travel time constraints between two interventions are shared by all the vehicles using the arc
+        std::map<std::pair<int, int>, int> pair_index;
+        arc_pair = std::vector<int>(arcs.size(), -1);
+        for (int a = 0; a < arcs.size(); a++) {
+            const CompactArc& arc = arcs[a];
+            if (arc.from >= instance.number_interventions || arc.to >= instance.number_interventions) {
+                continue;
+            }
+            auto [it, is_new] = pair_index.insert({{arc.from, arc.to}, (int) pair_arcs.size()});
+            if (is_new) {
+                pair_arcs.push_back({});
+            }
+            pair_arcs[it->second].push_back(a);
+            arc_pair[a] = it->second;
+        }
+        pair_added = std::vector<int>(pair_arcs.size(), 0);
+        depot_added = std::vector<int>(arcs.size(), 0);
+        lunch_added = std::vector<int>(instance.number_interventions, 0);
+    }
+
+protected:
+    void callback() override {
+        if (where != GRB_CB_MIPSOL) {
+            return;
+        }
+        double* x_values = getSolution(x.data(), x.size());
+        double* u_values = getSolution(u.data(), u.size());
+        double* z_values = getSolution(z.data(), z.size());
+        for (int a = 0; a < arcs.size(); a++) {
+            if (x_values[a] < 0.5) {
+                continue;
+            }
+            const CompactArc& arc = arcs[a];
+            int travel_time = instance.time_matrix[arc.from][arc.to];
+            if (arc.from >= instance.number_interventions) {
+                // From the depot
+                if (!depot_added[a] && u_values[arc.to] < travel_time - 1e-6) {
+                    addLazy(travel_time * x[a] <= u[arc.to]);
+                    depot_added[a] = 1;
+                    n_added++;
+                }
+            } else if (arc.to >= instance.number_interventions) {
+                // To the depot
+                int duration = instance.nodes[arc.from].duration;
+                if (!depot_added[a] && u_values[arc.from] + duration + travel_time > END_DAY + 1e-6) {
+                    addLazy(u[arc.from] + duration + travel_time * x[a] <= END_DAY);
+                    depot_added[a] = 1;
+                    n_added++;
+                }
+            } else {
+                // Between two interventions, with the same big M as the dense model
+                const Node& node_i = instance.nodes[arc.from];
+                int p = arc_pair[a];
+                if (!pair_added[p] && u_values[arc.from] + node_i.duration + travel_time > u_values[arc.to] + 1e-6) {
+                    GRBLinExpr expr = u[arc.from] - node_i.end_window;
+                    double coef = node_i.end_window + node_i.duration + travel_time;
+                    for (int b : pair_arcs[p]) {
+                        expr += coef * x[b];
+                    }
+                    addLazy(expr <= u[arc.to]);
+                    pair_added[p] = 1;
+                    n_added++;
+                }
+            }
+        }
+        // Lunch break of the ambiguous interventions
+        for (int i = 0; i < instance.number_interventions; i++) {
+            if (!instance.nodes[i].is_ambiguous || lunch_added[i]) {
+                continue;
+            }
+            int duration = instance.nodes[i].duration;
+            bool is_violated = u_values[i] + duration > MID_DAY + (END_DAY - MID_DAY) * z_values[i] + 1e-6
+                || u_values[i] < MID_DAY * z_values[i] - 1e-6;
+            if (is_violated) {
+                addLazy(u[i] + duration <= MID_DAY + (END_DAY - MID_DAY) * z[i]);
+                addLazy(u[i] >= MID_DAY * z[i]);
+                lunch_added[i] = 1;
+                n_added += 2;
+            }
+        }
+        delete[] x_values;
+        delete[] u_values;
+        delete[] z_values;
+    }
+
+private:
+    const Instance& instance;
+    const std::vector<CompactArc>& arcs;
+    const std::vector<GRBVar>& x;
+    const std::vector<GRBVar>& u;
+    const std::vector<GRBVar>& z;
+    // Pair of interventions of each arc (-1 for the depot arcs), and arcs of each pair
+    std::vector<int> arc_pair;
+    std::vector<std::vector<int>> pair_arcs;
+    // Constraints already added
+    std::vector<int> pair_added;
+    std::vector<int> depot_added;
+    std::vector<int> lunch_added;
+};
 
 
 CompactSolution<int> compact_solver(const Instance & instance, int time_limit, std::vector<Route> routes, int mode, bool verbose) {
-    using std::vector, std::find;
+    using std::vector;
     using std::pair;
     using std::string;
         
@@ -16,7 +173,6 @@ CompactSolution<int> compact_solver(const Instance & instance, int time_limit, s
     int n_interventions = instance.number_interventions;
     int n_nodes = instance.nodes.size();
     int n_vehicles = instance.number_vehicles;
-    int n_resources = instance.capacities_labels.size();
 
     try {
         // Create the model
@@ -30,169 +186,98 @@ CompactSolution<int> compact_solver(const Instance & instance, int time_limit, s
         }
         
         GRBModel model = GRBModel(env);
-
-
-        // Build the 3D list of variables x_ijv
-        vector<vector<vector<GRBVar>>> x(n_nodes, vector<vector<GRBVar>>(n_nodes, vector<GRBVar>(n_vehicles)));
-        for (int i = 0; i < n_nodes; i++) {
-            for (int j = 0; j < n_nodes; j++) {
-                for (int v = 0; v < n_vehicles; v++) {
-                    x[i][j][v] = model.addVar(0.0, 1.0, 0.0, GRB_BINARY);
-                }
-            }
+        model.set(GRB_IntParam_LazyConstraints, 1);
+
+        // Variables x_ijv, only for the feasible arcs
+        vector<CompactArc> arcs = compact_arcs(instance);
+        vector<GRBVar> x(arcs.size());
+        for (int a = 0; a < arcs.size(); a++) {
+            const CompactArc& arc = arcs[a];
+            // The depots have no duration
+            int duration = arc.from < n_interventions ? instance.nodes[arc.from].duration : 0;
+            double coef = instance.M * duration - instance.distance_matrix[arc.from][arc.to] * instance.cost_per_km;
+            x[a] = model.addVar(0.0, 1.0, coef, GRB_BINARY);
         }
         // The list of variables y_v
         vector<GRBVar> y(n_vehicles);
         for (int v = 0; v < n_vehicles; v++) {
-            y[v] = model.addVar(0.0, 1.0, 0.0, GRB_BINARY);
+            y[v] = model.addVar(0.0, 1.0, - instance.vehicles[v].cost, GRB_BINARY);
         }
-        // The variables u_i (start time of intervention i)
+        // The variables u_i (start time of intervention i), within the time windows
         vector<GRBVar> u(n_interventions);
         for (int i = 0; i < n_interventions; i++) {
-            u[i] = model.addVar(0.0, GRB_INFINITY, 0.0, GRB_INTEGER);
+            const Node& intervention = instance.nodes[i];
+            double latest_start = std::max(intervention.start_window, intervention.end_window - intervention.duration);
+            u[i] = model.addVar(intervention.start_window, latest_start, 0.0, GRB_INTEGER);
         }
         // The variables z_i (wether intervention i is done in the afternoon)
         vector<GRBVar> z(n_interventions);
         for (int i = 0; i < n_interventions; i++) {
             z[i] = model.addVar(0.0, 1.0, 0.0, GRB_BINARY);
         }
-
-        // Add the constraints
-        // Custom constraint : you cannot go into a depot that is not your own, and you cannot go out of a depot that is not your own
-        for (int v = 0; v < n_vehicles; v++) {
-            int real_depot = instance.vehicles[v].depot;
-            for (int i = 0; i < n_nodes; i++) {
-                for (int j = n_interventions; j < n_nodes; j++) {
-                    if (j == real_depot) continue;
-                    model.addConstr(x[i][j][v] == 0);
-                    model.addConstr(x[j][i][v] == 0);
-                }
+        model.set(GRB_IntAttr_ModelSense, GRB_MAXIMIZE);
+
+        // Gather the arcs by intervention and by (node, vehicle)
+        vector<GRBLinExpr> visits(n_interventions);
+        vector<GRBLinExpr> flow(n_nodes * n_vehicles);
+        vector<GRBLinExpr> depot_out(n_vehicles);
+        vector<GRBLinExpr> depot_in(n_vehicles);
+        vector<vector<GRBLinExpr>> capacities(instance.capacities_labels.size(), vector<GRBLinExpr>(n_vehicles));
+        for (int a = 0; a < arcs.size(); a++) {
+            const auto& [i, j, v] = arcs[a];
+            flow[i * n_vehicles + v] += x[a];
+            flow[j * n_vehicles + v] -= x[a];
+            if (i >= n_interventions) {
+                depot_out[v] += x[a];
+                continue;
             }
-        }
-        //Each intervention is visited at most once
-        for (int i = 0; i < n_interventions; i++) {
-            GRBLinExpr expr = 0;
-            for (int j = 0; j < n_nodes; j++) {
-                for (int v = 0; v < n_vehicles; v++) {
-                    expr += x[i][j][v];
-                }
+            if (j >= n_interventions) {
+                depot_in[v] += x[a];
             }
-            model.addConstr(expr <= 1);
-        }
-        // Vehicle routing contraints
-        // Can't go from a node to itself
-        for (int i = 0; i < n_nodes; i++) {
-            for (int v = 0; v < n_vehicles; v++) {
-                model.addConstr(x[i][i][v] == 0);
-            }
-        }
-        // Flow conservation constraints
-        for (int i = 0; i < n_nodes; i++) {
-            for (int v = 0; v < n_vehicles; v++) {
-                GRBLinExpr expr = 0;
-                for (int j = 0; j < n_nodes; j++) {
-                    expr += x[i][j][v] - x[j][i][v];
-                }
-                model.addConstr(expr == 0);
-            }
-        }
-        // A vehicle leaves the depot only if used
-        for (int v = 0; v < n_vehicles; v++) {
-            int depot = instance.vehicles[v].depot;
-            GRBLinExpr expr_out = 0;
-            GRBLinExpr expr_in = 0;
-            for (int j = 0; j < n_nodes; j++) {
-                expr_out += x[depot][j][v];
-                expr_in += x[j][depot][v];
-            }
-            model.addConstr(expr_out == y[v]);
-            model.addConstr(expr_in == y[v]);
-        }
-        // A vehicle can't be used if not available
-        for (int i = 0; i < n_nodes; i++) {
-            for (int j = 0; j < n_nodes; j++) {
-                for (int v = 0; v < n_vehicles; v++) {
-                    model.addConstr(x[i][j][v] <= y[v]);
-                }
+            visits[i] += x[a];
+            for (int c = 0; c < instance.capacities_labels.size(); c++) {
+                capacities[c][v] += instance.nodes[i].quantity_values[c] * x[a];
             }
         }
 
-        // Skill constraints
+        // Each intervention is visited at most once
         for (int i = 0; i < n_interventions; i++) {
-            for (int v = 0; v < n_vehicles; v++) {
-                // Check wether vehcile v can do intervention i
-                const Vehicle& vehicle = instance.vehicles[v];
-                int can_do = find(vehicle.interventions.begin(), vehicle.interventions.end(), i) != vehicle.interventions.end();
-                for (int j = 0; j < n_nodes; j++) {
-                    model.addConstr(x[i][j][v] <= can_do);
-                }
+            if (visits[i].size() > 0) {
+                model.addConstr(visits[i] <= 1);
             }
         }
-
-        // Intervention scheduling constraints
-        // Respecting the time windows
-        for (int i = 0; i < n_interventions; i++) {
-            const Node& intervention = instance.nodes[i];
-            model.addConstr(u[i] >= intervention.start_window);
-            model.addConstr(u[i] + intervention.duration <= intervention.end_window);
-        }
-        // Respecting the travel time
-        for (int i = 0; i < n_interventions; i++) {
-            for (int j = 0; j < n_interventions; j++) {
-                const Node& node_i = instance.nodes[i];
-                const Node& node_j = instance.nodes[j];
-                GRBLinExpr expr = u[i] - node_i.end_window;
-                double coef = node_i.end_window + node_i.duration + instance.time_matrix[i][j];
-                for (int v = 0; v < n_vehicles; v++) {
-                    expr += coef * x[i][j][v];
-                }
-                model.addConstr(expr <= u[j]);
-            }
-        }
-        // Also respect the travel time to and from the depot
-        for (int i = 0; i < n_interventions; i++) {
-            const Node & node_i = instance.nodes[i];
-            for (int v = 0; v < n_vehicles; v++) {
-                int depot = instance.vehicles[v].depot;
-                const Node & depot_node = instance.nodes[depot];
-                int travel_time_out = instance.time_matrix[depot][i];
-                int travel_time_in = instance.time_matrix[i][depot];
-                // from the depot
-                model.addConstr(travel_time_out * x[depot][i][v] <= u[i]);
-                // to the depot
-                model.addConstr(u[i] + node_i.duration + travel_time_in* x[i][depot][v] <= END_DAY);
+        // Flow conservation constraints
+        for (int k = 0; k < n_nodes * n_vehicles; k++) {
+            if (flow[k].size() > 0) {
+                model.addConstr(flow[k] == 0);
             }
         }
-        // Lunch break
-        for (int i = 0; i < n_interventions; i++) {
-            if (!instance.nodes[i].is_ambiguous) continue;
-            int duration = instance.nodes[i].duration;
-            model.addConstr(u[i] + duration <= MID_DAY + (END_DAY - MID_DAY) * z[i]);
-            model.addConstr(u[i] >= MID_DAY * z[i]);
+        // A vehicle leaves its depot only if used (a route without the depot is cut by the travel time constraints)
+        for (int v = 0; v < n_vehicles; v++) {
+            model.addConstr(depot_out[v] == y[v]);
+            model.addConstr(depot_in[v] == y[v]);
         }
         // Capacities constraints
-        for (const string & label : instance.capacities_labels) {
+        for (int c = 0; c < instance.capacities_labels.size(); c++) {
             for (int v = 0; v < n_vehicles; v++) {
-                GRBLinExpr expr = 0;
-                for (int i = 0; i < n_interventions; i++) {
-                    for (int j = 0; j < n_nodes; j++) {
-                        expr += instance.nodes[i].quantities.at(label) * x[i][j][v];
-                    }
-                }
-                model.addConstr(expr <= instance.vehicles[v].capacities.at(label));
+                model.addConstr(capacities[c][v] <= instance.vehicles[v].capacity_values[c]);
             }
         }
 
         // Mode specific constraints
         if (mode == WARM_START) {
-            // Warm start : we use the routes to set the variables
-            for (const Route & route : routes) {
-                int v = route.vehicle_id;
-                for (int i = 0; i < route.id_sequence.size() - 1; i++) {
-                    int node_i = route.id_sequence[i];
-                    int node_j = route.id_sequence[i+1];
-                    x[node_i][node_j][v].set(GRB_DoubleAttr_Start, 1.0);
-                }
+            // Warm start : the routes are converted to a complete MIP start (x, y, u and z)
+            CompactSolution<int> start = to_compact_solution(AllOnesSolution(routes.size()), routes, instance);
+            for (int a = 0; a < arcs.size(); a++) {
+                const auto& [i, j, v] = arcs[a];
+                x[a].set(GRB_DoubleAttr_Start, start.x[i][j][v]);
+            }
+            for (int v = 0; v < n_vehicles; v++) {
+                y[v].set(GRB_DoubleAttr_Start, start.y[v] > 0);
+            }
+            for (int i = 0; i < n_interventions; i++) {
+                u[i].set(GRB_DoubleAttr_Start, start.u[i]);
+                z[i].set(GRB_DoubleAttr_Start, start.z[i]);
             }
         }
         if (mode == IMPOSE_ROUTING) {
@@ -202,56 +287,48 @@ CompactSolution<int> compact_solver(const Instance & instance, int time_limit, s
             // Finally, we can set the imposed routings
             // Each pair is a pair (vehicle_id, intervention_id)
             // Where the vehicle has to go through the intervention
-            for (const auto& [v, i] : imposed_routings) {
-                GRBLinExpr expr = 0;
-                for (int j = 0; j < n_nodes; j++) {
-                    expr += x[i][j][v];
-                }
-                model.addConstr(expr == 1);
+            std::map<pair<int, int>, int> imposed_index;
+            for (int k = 0; k < imposed_routings.size(); k++) {
+                imposed_index[imposed_routings[k]] = k;
             }
-        }
-            
-
-        // Set the objective function
-        GRBLinExpr obj = 0;
-        for (int i = 0; i < n_nodes; i++) {
-            const Node & node_i = instance.nodes[i];
-            for (int j = 0; j < n_nodes; j++) {
-                const Node & node_j = instance.nodes[j];
-                int distance = instance.distance_matrix[i][j];
-                for (int v = 0; v < n_vehicles; v++) {
-                    obj += (instance.M * node_i.duration - distance * instance.cost_per_km) * x[i][j][v];
+            vector<GRBLinExpr> imposed(imposed_routings.size());
+            for (int a = 0; a < arcs.size(); a++) {
+                auto it = imposed_index.find({arcs[a].vehicle, arcs[a].from});
+                if (it != imposed_index.end()) {
+                    imposed[it->second] += x[a];
                 }
             }
+            for (int k = 0; k < imposed_routings.size(); k++) {
+                model.addConstr(imposed[k] == 1);
+            }
         }
-        // Substract the cost of the vehicles
-        for (int v = 0; v < n_vehicles; v++) {
-            obj -= instance.vehicles[v].cost * y[v];
-        }
-        model.setObjective(obj, GRB_MAXIMIZE);
 
-        // Optimize the model
+        // Optimize the model, the travel time and lunch break constraints are added lazily
+        CompactLazyConstraints lazy_constraints(instance, arcs, x, u, z);
+        model.setCallback(&lazy_constraints);
         model.optimize();
+        if (verbose) {
+            std::cout << "Sparse compact model : " << arcs.size() << " arcs (dense model : " << (long) n_nodes * n_nodes * n_vehicles << ")";
+            std::cout << " - " << lazy_constraints.n_added << " lazy constraints added" << std::endl;
+        }
 
         // Build the solution
         CompactSolution<int> solution = CompactSolution<int>(n_nodes, n_interventions, n_vehicles);
         solution.objective_value = model.get(GRB_DoubleAttr_ObjVal);
 
         // Get the values of the variables x_ijv
-        for (int i = 0; i < n_nodes; i++) {
-            for (int j = 0; j < n_nodes; j++) {
-                for (int v = 0; v < n_vehicles; v++) {
-                    solution.x[i][j][v] = x[i][j][v].get(GRB_DoubleAttr_X);
-                }
-            }
+        for (int a = 0; a < arcs.size(); a++) {
+            const auto& [i, j, v] = arcs[a];
+            solution.x[i][j][v] = std::round(x[a].get(GRB_DoubleAttr_X));
         }
         // Get the values of the variables y_v
         for (int v = 0; v < n_vehicles; v++) {
             solution.y[v] = y[v].get(GRB_DoubleAttr_X);
         }
-        // Get the values of the variables u_i
+        // Get the values of the variables u_i and z_i
         for (int i = 0; i < n_interventions; i++) {
             solution.u[i] = u[i].get(GRB_DoubleAttr_X);
+            solution.z[i] = std::round(z[i].get(GRB_DoubleAttr_X));
         }
 
         return solution;
@@ -531,4 +608,169 @@ CompactSolution<double> relaxed_compact_solver(const Instance & instance, int ti
     }
 
     return solution;
-}   
\ No newline at end of file
+}   
+
+
+CompactRelaxation sparse_relaxed_compact_solver(const Instance & instance, int time_limit, bool verbose) {
+    using std::vector;
+    using std::pair;
+
+    int n_interventions = instance.number_interventions;
+    int n_nodes = instance.nodes.size();
+    int n_vehicles = instance.number_vehicles;
+
+    CompactRelaxation relaxation;
+    try {
+        // Create the model
+        GRBEnv env = GRBEnv(true);
+        env.start();
+        // Set the time limit
+        env.set(GRB_DoubleParam_TimeLimit, time_limit);
+        // Set the verbosity
+        if (!verbose) {
+            env.set(GRB_IntParam_OutputFlag, 0);
+        }
+
+        GRBModel model = GRBModel(env);
+
+        // Variables x_ijv, only for the feasible arcs, all the variables are continuous
+        vector<CompactArc> arcs = compact_arcs(instance);
+        vector<GRBVar> x(arcs.size());
+        for (int a = 0; a < arcs.size(); a++) {
+            const CompactArc& arc = arcs[a];
+            int duration = arc.from < n_interventions ? instance.nodes[arc.from].duration : 0;
+            double coef = instance.M * duration - instance.distance_matrix[arc.from][arc.to] * instance.cost_per_km;
+            x[a] = model.addVar(0.0, 1.0, coef, GRB_CONTINUOUS);
+        }
+        // The bound of the y_v variables is a constraint, to get the dual of the vehicles
+        vector<GRBVar> y(n_vehicles);
+        for (int v = 0; v < n_vehicles; v++) {
+            y[v] = model.addVar(0.0, GRB_INFINITY, - instance.vehicles[v].cost, GRB_CONTINUOUS);
+        }
+        vector<GRBVar> u(n_interventions);
+        for (int i = 0; i < n_interventions; i++) {
+            const Node& intervention = instance.nodes[i];
+            double latest_start = std::max(intervention.start_window, intervention.end_window - intervention.duration);
+            u[i] = model.addVar(intervention.start_window, latest_start, 0.0, GRB_CONTINUOUS);
+        }
+        vector<GRBVar> z(n_interventions);
+        for (int i = 0; i < n_interventions; i++) {
+            z[i] = model.addVar(0.0, 1.0, 0.0, GRB_CONTINUOUS);
+        }
+        model.set(GRB_IntAttr_ModelSense, GRB_MAXIMIZE);
+
+        // Gather the arcs by intervention, by (node, vehicle) and by pair of interventions
+        vector<GRBLinExpr> visits(n_interventions);
+        vector<GRBLinExpr> flow(n_nodes * n_vehicles);
+        vector<GRBLinExpr> depot_out(n_vehicles);
+        vector<GRBLinExpr> depot_in(n_vehicles);
+        vector<vector<GRBLinExpr>> capacities(instance.capacities_labels.size(), vector<GRBLinExpr>(n_vehicles));
+        std::map<pair<int, int>, GRBLinExpr> travel;
+        for (int a = 0; a < arcs.size(); a++) {
+            const auto& [i, j, v] = arcs[a];
+            flow[i * n_vehicles + v] += x[a];
+            flow[j * n_vehicles + v] -= x[a];
+            if (i >= n_interventions) {
+                depot_out[v] += x[a];
+                // Travel time from the depot
+                model.addConstr(instance.time_matrix[i][j] * x[a] <= u[j]);
+                continue;
+            }
+            if (j >= n_interventions) {
+                depot_in[v] += x[a];
+                // Travel time to the depot
+                model.addConstr(u[i] + instance.nodes[i].duration + instance.time_matrix[i][j] * x[a] <= END_DAY);
+            } else {
+                travel[{i, j}] += x[a];
+            }
+            visits[i] += x[a];
+            for (int c = 0; c < instance.capacities_labels.size(); c++) {
+                capacities[c][v] += instance.nodes[i].quantity_values[c] * x[a];
+            }
+        }
+
+        // Each intervention is visited at most once (its dual is the alpha of the master problem)
+        vector<GRBConstr> visit_ctrs(n_interventions);
+        vector<int> has_visit_ctr(n_interventions, 0);
+        for (int i = 0; i < n_interventions; i++) {
+            if (visits[i].size() > 0) {
+                visit_ctrs[i] = model.addConstr(visits[i] <= 1);
+                has_visit_ctr[i] = 1;
+            }
+        }
+        // Each vehicle is used at most once (its dual is the beta of the master problem)
+        vector<GRBConstr> vehicle_ctrs(n_vehicles);
+        for (int v = 0; v < n_vehicles; v++) {
+            vehicle_ctrs[v] = model.addConstr(y[v] <= 1);
+            model.addConstr(depot_out[v] == y[v]);
+            model.addConstr(depot_in[v] == y[v]);
+        }
+        // Flow conservation constraints
+        for (int k = 0; k < n_nodes * n_vehicles; k++) {
+            if (flow[k].size() > 0) {
+                model.addConstr(flow[k] == 0);
+            }
+        }
+        // Capacities constraints
+        for (int c = 0; c < instance.capacities_labels.size(); c++) {
+            for (int v = 0; v < n_vehicles; v++) {
+                model.addConstr(capacities[c][v] <= instance.vehicles[v].capacity_values[c]);
+            }
+        }
+        // Travel time between two interventions, shared by all the vehicles
+        for (auto& [ij, expr] : travel) {
+            const auto& [i, j] = ij;
+            const Node& node_i = instance.nodes[i];
+            double coef = node_i.end_window + node_i.duration + instance.time_matrix[i][j];
+            model.addConstr(u[i] - node_i.end_window + coef * expr <= u[j]);
+        }
+        // Lunch break
+        for (int i = 0; i < n_interventions; i++) {
+            if (!instance.nodes[i].is_ambiguous) continue;
+            int duration = instance.nodes[i].duration;
+            model.addConstr(u[i] + duration <= MID_DAY + (END_DAY - MID_DAY) * z[i]);
+            model.addConstr(u[i] >= MID_DAY * z[i]);
+        }
+
+        model.optimize();
+        if (verbose) {
+            std::cout << "Sparse relaxed compact model : " << arcs.size() << " arcs" << std::endl;
+        }
+
+        // Build the solution
+        CompactSolution<double>& solution = relaxation.solution;
+        solution = CompactSolution<double>(n_nodes, n_interventions, n_vehicles);
+        solution.objective_value = model.get(GRB_DoubleAttr_ObjVal);
+        for (int a = 0; a < arcs.size(); a++) {
+            const auto& [i, j, v] = arcs[a];
+            solution.x[i][j][v] = x[a].get(GRB_DoubleAttr_X);
+        }
+        for (int v = 0; v < n_vehicles; v++) {
+            solution.y[v] = y[v].get(GRB_DoubleAttr_X);
+        }
+        for (int i = 0; i < n_interventions; i++) {
+            solution.u[i] = u[i].get(GRB_DoubleAttr_X);
+        }
+
+        // Duals, as in the maximisation formulation of the master problem
+        relaxation.dual_solution.alphas = vector<double>(n_interventions, 0);
+        for (int i = 0; i < n_interventions; i++) {
+            if (has_visit_ctr[i]) {
+                relaxation.dual_solution.alphas[i] = visit_ctrs[i].get(GRB_DoubleAttr_Pi);
+            }
+        }
+        relaxation.dual_solution.betas = vector<double>(n_vehicles, 0);
+        for (int v = 0; v < n_vehicles; v++) {
+            relaxation.dual_solution.betas[v] = vehicle_ctrs[v].get(GRB_DoubleAttr_Pi);
+        }
+        relaxation.is_feasible = true;
+
+    } catch (GRBException & e) {
+        std::cerr << "Error code = " << e.getErrorCode() << std::endl;
+        std::cerr << e.getMessage() << std::endl;
+    } catch (...) {
+        std::cerr << "Exception during optimization" << std::endl;
+    }
+
+    return relaxation;
+}
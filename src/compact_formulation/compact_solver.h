@@ -12,8 +12,22 @@ inline constexpr int WARM_START = 1;
 inline constexpr int IMPOSE_ROUTING = 2;
 
 
+// Arc (from, to) of the compact model, for one vehicle
+struct CompactArc {
+    int from;
+    int to;
+    int vehicle;
+};
+
+// Arcs of the sparse compact model : for each vehicle, the arcs between its depot and the interventions it can do
+// (skills) in time, and between two of these interventions when the time windows allow it (see is_edge_feasible)
+std::vector<CompactArc> compact_arcs(const Instance& instance);
+
+
 /*
     Solves the compact model for the problem
+    Sparse model : the variables x_ijv are only created for the arcs of compact_arcs, and the travel time
+    and lunch break constraints are added lazily, when an integer solution violates them
     @param instance: the instance of the problem
     @param time_limit: the time limit for the solver
     @param routes : a vector of routes to help the solver (default empty)
@@ -21,7 +35,8 @@ inline constexpr int IMPOSE_ROUTING = 2;
 
     NO_ROUTING : no additional information is given to the solver   
 
-    WARM_START : the routes are use to warm start the variables   
+    WARM_START : the routes are converted to a complete MIP start (x, y, u and z, see to_compact_solution)
+    they must form a feasible solution (at most one route per vehicle, each intervention covered at most once)   
 
     IMPOSE_ROUTING : the routes are used to impose the routing of the vehicles  
 
@@ -41,3 +56,26 @@ CompactSolution<int> compact_solver(const Instance& instance, int time_limit = 6
     @return a CompactSolution struct with the values of the variables
 */
 CompactSolution<double> relaxed_compact_solver(const Instance& instance, int time_limit = 60, bool verbose = false);
+
+
+/*
+    @struct CompactRelaxation
+    @brief Linear relaxation of the sparse compact model, used to seed the column generation
+*/
+struct CompactRelaxation {
+    bool is_feasible = false;
+    // Arc flows x_ijv, vehicles y_v and start times u_i of the relaxation
+    CompactSolution<double> solution;
+    // Duals of the visit constraints (alphas) and of the vehicle constraints (betas), with the sign conventions
+    // of the maximisation formulation of the master problem
+    DualSolution dual_solution;
+};
+
+/*
+    Solves the linear relaxation of the sparse compact model (same arcs as compact_solver, all the variables continuous)
+    The travel time and lunch break constraints are all in the model, the relaxation being a linear program
+    @param instance: the instance of the problem
+    @param time_limit: the time limit for the solver
+    @param verbose : a boolean to print the output of the solver
+*/
+CompactRelaxation sparse_relaxed_compact_solver(const Instance& instance, int time_limit = 60, bool verbose = false);
@@ -1,6 +1,13 @@
 #include "solution_converter.h"
 
+#include "instance/constants.h"
+#include "instance/preprocessing.h"
+#include "routes/route_evaluation.h"
+
 #include <iostream>
+#include <vector>
+#include <set>
+#include <algorithm>
 
 
 std::vector<Route> compact_solution_to_routes(const Instance& instance, const CompactSolution<int>& compact_solution) {
@@ -131,16 +138,15 @@ CompactSolution<int> to_compact_solution(const IntegerSolution& integer_solution
 
     // Initialize the compact solution - the vectors are already initialized to 0
     CompactSolution<int> compact_solution(n_nodes, n_intervention, n_vehicles);
+    vector<int> is_covered(n_intervention, 0);
 
     // Enumerate through all routes to update the compact solution
     for (int r = 0; r < routes.size(); r++) {
         // Skip the routes that are not used
         if (integer_solution.coefficients[r] == 0) continue;
         const Route& route = routes[r];
-        // Update the y variable - the vehicle v is used x_r times (x_r is fractional)
+        // Update the y variable - the vehicle v is used x_r times
         compact_solution.y[route.vehicle_id] += integer_solution.coefficients[r];
-        // We don't care about the u and z variables for now - they are onyl relevant for defining an admissible solution
-        // But do not count in the cost of the solution
         // Update the x variables
         for (int i = 0; i < route.id_sequence.size() - 1; i++) {
             int current_node = route.id_sequence[i];
@@ -148,7 +154,107 @@ CompactSolution<int> to_compact_solution(const IntegerSolution& integer_solution
             //cout << "Current node : " << current_node << " / Next node : " << next_node << endl;
             compact_solution.x[current_node][next_node][route.vehicle_id] += integer_solution.coefficients[r];
         }
+        // The u variables are the earliest start times along the route
+        RouteSchedule schedule = schedule_route(route, instance);
+        for (int k = 1; k + 1 < schedule.sequence.size(); k++) {
+            compact_solution.u[schedule.sequence[k]] = schedule.earliest_start[k];
+            is_covered[schedule.sequence[k]] = 1;
+        }
+    }
+
+    // The other interventions start as early as possible, and the z variables follow the start times
+    for (int i = 0; i < n_intervention; i++) {
+        if (!is_covered[i]) {
+            compact_solution.u[i] = earliest_start(instance.nodes[i], 0);
+        }
+        compact_solution.z[i] = instance.nodes[i].is_ambiguous && compact_solution.u[i] >= MID_DAY;
     }
 
     return compact_solution;
 }
+
+
+std::vector<Route> decompose_compact_flow(const Instance& instance, const CompactSolution<double>& compact_solution) {
+    using std::vector;
+
+    // Flow under which an arc is considered empty
+    constexpr double FLOW_EPSILON = 1e-6;
+    int n_nodes = instance.nodes.size();
+
+    vector<Route> routes;
+    for (const Vehicle& vehicle : instance.vehicles) {
+        int v = vehicle.id;
+        vector<vector<double>> flow(n_nodes, vector<double>(n_nodes, 0));
+        for (int i = 0; i < n_nodes; i++) {
+            for (int j = 0; j < n_nodes; j++) {
+                flow[i][j] = compact_solution.x[i][j][v];
+            }
+        }
+        auto next_node = [&](int i) {
+            int next = -1;
+            for (int j = 0; j < n_nodes; j++) {
+                if (flow[i][j] > FLOW_EPSILON && (next == -1 || flow[i][j] > flow[i][next])) {
+                    next = j;
+                }
+            }
+            return next;
+        };
+        // Removes the smallest flow of the path sequence[first..] from its arcs
+        auto remove_path = [&](const vector<int>& sequence, int first) {
+            double min_flow = 1;
+            for (int k = first; k + 1 < sequence.size(); k++) {
+                min_flow = std::min(min_flow, flow[sequence[k]][sequence[k + 1]]);
+            }
+            for (int k = first; k + 1 < sequence.size(); k++) {
+                flow[sequence[k]][sequence[k + 1]] -= min_flow;
+            }
+        };
+
+        std::set<vector<int>> sequences;
+        // Each path removes the flow of at least one arc
+        for (int path = 0; path < n_nodes * n_nodes && next_node(vehicle.depot) != -1; path++) {
+            vector<int> sequence = {vehicle.depot};
+            vector<int> position(n_nodes, -1);
+            position[vehicle.depot] = 0;
+            while (true) {
+                int next = next_node(sequence.back());
+                if (next == -1) {
+                    // Flow that does not come back to the depot (not conserved), removed from the path
+                    remove_path(sequence, 0);
+                    sequence.clear();
+                    break;
+                }
+                if (next == vehicle.depot) {
+                    sequence.push_back(next);
+                    remove_path(sequence, 0);
+                    break;
+                }
+                if (position[next] != -1) {
+                    // Cancel the cycle and continue the path from its first node
+                    int first = position[next];
+                    sequence.push_back(next);
+                    remove_path(sequence, first);
+                    for (int k = first + 1; k < sequence.size() - 1; k++) {
+                        position[sequence[k]] = -1;
+                    }
+                    sequence.resize(first + 1);
+                    continue;
+                }
+                position[next] = sequence.size();
+                sequence.push_back(next);
+            }
+            if (sequence.size() <= 2 || sequences.contains(sequence)) continue;
+            if (!schedule_route(sequence, instance, vehicle).is_feasible) continue;
+            sequences.insert(sequence);
+
+            // Sequence of in-vehicle indices, as built by the pricing algorithms
+            vector<int> vehicle_sequence = {-1};
+            for (int k = 1; k + 1 < sequence.size(); k++) {
+                vehicle_sequence.push_back(vehicle.reverse_interventions[sequence[k]]);
+            }
+            vehicle_sequence.push_back(-1);
+            routes.push_back(convert_sequence_to_route(0, vehicle_sequence, instance, vehicle));
+        }
+    }
+    return routes;
+}
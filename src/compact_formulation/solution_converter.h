@@ -12,4 +12,12 @@ std::vector<Route> compact_solution_to_routes(const Instance& instance, const Co
 
 CompactSolution<double> to_compact_solution(const MasterSolution& master_solution, const std::vector<Route>& routes, const Instance& instance);
 
-CompactSolution<int> to_compact_solution(const IntegerSolution& integer_solution, const std::vector<Route>& routes, const Instance& instance);
\ No newline at end of file
+// Converts an integer solution, with the start times of the interventions (earliest starts along the routes)
+// The interventions that are not covered start at their earliest possible time, so that the solution is a valid MIP start
+CompactSolution<int> to_compact_solution(const IntegerSolution& integer_solution, const std::vector<Route>& routes, const Instance& instance);
+
+// Decomposes the arc flow of a relaxed compact solution into routes, vehicle by vehicle
+// Each path follows the arcs with the largest flow from the depot, and its smallest flow is removed from its arcs
+// (a cycle met on the way is cancelled the same way), until no flow leaves the depot
+// Only the feasible routes are kept, each sequence once per vehicle
+std::vector<Route> decompose_compact_flow(const Instance& instance, const CompactSolution<double>& compact_solution);
@@ -50,7 +50,11 @@ nlohmann::json export_parameters(const ColumnGenerationParameters& parameters) {
         {"ng", parameters.ng},
         {"dssr", parameters.dssr},
         {"use_visited", parameters.use_visited},
-        {"pathwyse_time_limit", parameters.pathwyse_TL}
+        {"pathwyse_time_limit", parameters.pathwyse_TL},
+        {"pricing_tiers", parameters.pricing_tiers},
+        {"heuristic_queue_limit", parameters.heuristic_queue_limit},
+        {"tabu_iterations", parameters.tabu_iterations},
+        {"tabu_tenure", parameters.tabu_tenure}
     };
 
     // Pulse related parameters
@@ -65,6 +69,27 @@ nlohmann::json export_parameters(const ColumnGenerationParameters& parameters) {
         {"use_stabilisation", parameters.use_stabilisation}
     };
 
+    // Diving heuristic parameters
+    j["diving"] = {
+        {"use_diving_heuristic", parameters.use_diving_heuristic},
+        {"diving_iterations", parameters.diving_iterations},
+        {"diving_max_backtracks", parameters.diving_max_backtracks}
+    };
+
+    // Compact relaxation seeding parameters
+    j["compact_seed"] = {
+        {"use_compact_seed", parameters.use_compact_seed},
+        {"compact_seed_time_limit", parameters.compact_seed_time_limit}
+    };
+
+    // Subset row cuts parameters
+    j["subset_row_cuts"] = {
+        {"use_subset_row_cuts", parameters.use_subset_row_cuts},
+        {"max_subset_row_cuts", parameters.max_subset_row_cuts},
+        {"max_subset_row_rounds", parameters.max_subset_row_rounds},
+        {"use_limited_memory_subset_row_cuts", parameters.use_limited_memory_subset_row_cuts}
+    };
+
     // Pricing function
     j["pricing_function"] = parameters.pricing_function;
     return j;
@@ -104,6 +129,13 @@ void export_solution(
         {"time_to_compute", elapsed_time}
     };
 
+    // Number of pricing rounds that ended on each pricing tier
+    j["pricing_tiers_usage"] = json::object();
+    for (int t = 0; t < result.pricing_tiers.size(); t++){
+        j["pricing_tiers_usage"][result.pricing_tiers[t]] = result.pricing_tiers_usage[t];
+    }
+    j["untiered_pricing_rounds"] = result.untiered_pricing_rounds;
+
     // Add the routes
     j["routes"] = json::array();
     for (int i = 0; i < routes.size(); i++){
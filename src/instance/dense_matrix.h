@@ -0,0 +1,94 @@
+// Dense matrix stored in a single contiguous buffer
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+// Alignment of the rows of the matrices (one cache line)
+inline constexpr std::size_t MATRIX_ALIGNMENT = 64;
+
+
+// Allocator returning MATRIX_ALIGNMENT aligned memory
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n){
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(MATRIX_ALIGNMENT)));
+    }
+    void deallocate(T* p, std::size_t){
+        ::operator delete(p, std::align_val_t(MATRIX_ALIGNMENT));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const {return true;}
+};
+
+
+/*
+    @class DenseMatrix
+    @brief Matrix with all its rows in one buffer, each row starting on a cache line
+
+    matrix[i][j] reads the entry (i, j), as with a std::vector<std::vector<T>>
+    The rows are padded to a multiple of the cache line size
+*/
+template <typename T>
+class DenseMatrix {
+public:
+    using value_type = T;
+
+    // Empty matrix
+    DenseMatrix() {}
+
+    // Matrix of size n_rows x n_cols filled with value
+    DenseMatrix(int n_rows, int n_cols, T value = T()) :
+        n_rows(n_rows),
+        n_cols(n_cols),
+        stride(padded_size(n_cols)),
+        values((std::size_t) n_rows * padded_size(n_cols), value)
+        {}
+
+    // Copy of a matrix stored as a vector of rows (all the rows must have the same size)
+    DenseMatrix(const std::vector<std::vector<T>>& rows) :
+        DenseMatrix(rows.size(), rows.empty() ? 0 : rows[0].size()) {
+        for (int i = 0; i < n_rows; i++){
+            std::copy(rows[i].begin(), rows[i].end(), (*this)[i]);
+        }
+    }
+
+    T* operator[](int i) {return values.data() + (std::size_t) i * stride;}
+    const T* operator[](int i) const {return values.data() + (std::size_t) i * stride;}
+
+    // Number of rows (same as a std::vector of rows)
+    int size() const {return n_rows;}
+    int rows() const {return n_rows;}
+    int cols() const {return n_cols;}
+    bool empty() const {return n_rows == 0;}
+
+private:
+    int n_rows = 0;
+    int n_cols = 0;
+    // Distance (in elements) between the beginning of two consecutive rows
+    int stride = 0;
+    std::vector<T, AlignedAllocator<T>> values;
+
+    static int padded_size(int n){
+        constexpr int per_line = MATRIX_ALIGNMENT / sizeof(T) > 0 ? MATRIX_ALIGNMENT / sizeof(T) : 1;
+        return (n + per_line - 1) / per_line * per_line;
+    }
+};
+
+
+// Storage of the travel times
+// The times are in minutes within a work day, they fit on 16 bits (see the COMPACT_TIME_MATRIX build option)
+#ifdef COMPACT_TIME_MATRIX
+using TimeMatrix = DenseMatrix<int16_t>;
+#else
+using TimeMatrix = DenseMatrix<int>;
+#endif
@@ -1,27 +1,42 @@
 #include "instance.h"
 
+#include "instance/parallel.h"
 #include "clustering/clustering.h"
 
 #include <iostream>
 #include <bits/stdc++.h>
 #include <algorithm>
 
+void set_vehicle_interventions(Vehicle& vehicle, std::vector<int> interventions, int n_interventions){
+    vehicle.interventions = std::move(interventions);
+    vehicle.reverse_interventions.assign(n_interventions, -1);
+    vehicle.interventions_bits.assign((n_interventions + 63) / 64, 0);
+    for (int k = 0; k < vehicle.interventions.size(); k++){
+        int intervention = vehicle.interventions[k];
+        vehicle.reverse_interventions[intervention] = k;
+        vehicle.interventions_bits[intervention / 64] |= uint64_t(1) << (intervention % 64);
+    }
+}
+
+
 Vehicle vehicle_mask(const Vehicle& vehicle, const std::vector<int>& mask, bool mode){
+    // Copy the vehicle (with its dense skills and capacities), only the interventions change
+    Vehicle new_vehicle = vehicle;
     std::vector<int> new_interventions;
-    std::map<int, int> new_reverse_map;
     for (int intervention : vehicle.interventions){
         if (mask[intervention] == mode){
             new_interventions.push_back(intervention);
-            new_reverse_map[intervention] = new_interventions.size() - 1;
         }
     }
-    return Vehicle{vehicle.id, vehicle.technicians, vehicle.skills, new_interventions, new_reverse_map, vehicle.depot, vehicle.capacities, vehicle.cost};
+    set_vehicle_interventions(new_vehicle, std::move(new_interventions), vehicle.reverse_interventions.size());
+    return new_vehicle;
 }
 
 
-bool is_symmetric(const std::vector<std::vector<int>>& matrix) {
+template <typename T>
+bool is_symmetric(const DenseMatrix<T>& matrix) {
     // First, to be symetric, the matrix must be square
-    if (matrix.size() != matrix[0].size()){
+    if (matrix.rows() != matrix.cols()){
         return false;
     }
     for (int i = 0; i < matrix.size(); i++){
@@ -34,9 +49,10 @@ bool is_symmetric(const std::vector<std::vector<int>>& matrix) {
     return true;
 }
 
-int symmetry_gap(const std::vector<std::vector<int>>& matrix) {
+template <typename T>
+int symmetry_gap(const DenseMatrix<T>& matrix) {
     // First, to be symetric, the matrix must be square
-    if (matrix.size() != matrix[0].size()){
+    if (matrix.rows() != matrix.cols()){
         throw std::invalid_argument("Matrix is not square");
     }
     int biggest_diff = 0;
@@ -48,19 +64,88 @@ int symmetry_gap(const std::vector<std::vector<int>>& matrix) {
     return biggest_diff;
 }
 
-bool can_do_intervention(const Node& intervention, const Vehicle& vehicle){
-    // Check that the vehicle has the skills to do the intervention
-    for (const auto &[skill, quantity] : intervention.required_skills){
-        // If the skill is not in the vehicle, the vehicle cannot do the intervention
-        if (vehicle.skills.find(skill) == vehicle.skills.end()){
-            return false;
+// Used for the time and distance matrices
+template bool is_symmetric(const DenseMatrix<int>& matrix);
+template int symmetry_gap(const DenseMatrix<int>& matrix);
+#ifdef COMPACT_TIME_MATRIX
+template bool is_symmetric(const TimeMatrix& matrix);
+template int symmetry_gap(const TimeMatrix& matrix);
+#endif
+
+std::vector<std::string> index_labels(std::vector<Node>& nodes, std::vector<Vehicle>& vehicles, const std::vector<std::string>& capacities_labels){
+    // Collect every skill label, sorted so that the indexes do not depend on the order of the nodes
+    std::set<std::string> skills_set;
+    for (const Node& node : nodes){
+        for (const auto &[skill, quantity] : node.required_skills){
+            skills_set.insert(skill);
         }
-        // If the vehicle does not have enough technicians with the skill, the vehicle cannot do the intervention
-        if (vehicle.skills.at(skill) < quantity){
-            return false;
+    }
+    for (const Vehicle& vehicle : vehicles){
+        for (const auto &[skill, count] : vehicle.skills){
+            skills_set.insert(skill);
         }
     }
-    return true;
+    std::vector<std::string> skills_labels(skills_set.begin(), skills_set.end());
+
+    // Value of each label in a map, 0 if the label is missing
+    auto dense = [](const std::map<std::string, int>& values, const std::vector<std::string>& labels){
+        std::vector<int> dense_values(labels.size(), 0);
+        for (int k = 0; k < labels.size(); k++){
+            auto it = values.find(labels[k]);
+            if (it != values.end()){
+                dense_values[k] = it->second;
+            }
+        }
+        return dense_values;
+    };
+    for (Node& node : nodes){
+        node.quantity_values = dense(node.quantities, capacities_labels);
+        node.required_skill_counts = dense(node.required_skills, skills_labels);
+    }
+    for (Vehicle& vehicle : vehicles){
+        vehicle.skill_counts = dense(vehicle.skills, skills_labels);
+        vehicle.capacity_values = dense(vehicle.capacities, capacities_labels);
+    }
+    return skills_labels;
+}
+
+
+bool can_do_intervention(const Node& intervention, const Vehicle& vehicle){
+    // The vehicle must have at least as many technicians with each skill as required
+    // (a skill the vehicle does not have counts 0 technicians)
+    bool can_do = true;
+    for (int k = 0; k < intervention.required_skill_counts.size(); k++){
+        can_do &= vehicle.skill_counts[k] >= intervention.required_skill_counts[k];
+    }
+    return can_do;
+}
+
+
+DenseMatrix<uint8_t> compatibility_matrix(const std::vector<Node>& nodes, int n_interventions, const std::vector<Vehicle>& vehicles){
+    int n_vehicles = vehicles.size();
+    int n_skills = n_interventions > 0 ? nodes[0].required_skill_counts.size() : 0;
+    // Number of technicians with each skill, per vehicle (one row per skill)
+    DenseMatrix<int> skill_counts(n_skills, n_vehicles, 0);
+    for (int v = 0; v < n_vehicles; v++){
+        for (int k = 0; k < n_skills; k++){
+            skill_counts[k][v] = vehicles[v].skill_counts[k];
+        }
+    }
+    // Each required skill of an intervention filters all the vehicles at once (contiguous loop, vectorized by the compiler)
+    // The interventions are split between threads (each one writes its own rows)
+    DenseMatrix<uint8_t> compatible(n_interventions, n_vehicles, 1);
+    parallel_for(n_interventions, [&](int i){
+        uint8_t* row = compatible[i];
+        for (int k = 0; k < n_skills; k++){
+            int required = nodes[i].required_skill_counts[k];
+            if (required == 0) continue;
+            const int* counts = skill_counts[k];
+            for (int v = 0; v < n_vehicles; v++){
+                row[v] &= counts[v] >= required;
+            }
+        }
+    });
+    return compatible;
 }
 
 
@@ -70,6 +155,10 @@ bool is_edge_feasible(int i, int j, const Instance& instance){
 
     // Check the time window : can j be done if we depart from i at the last possible moment ?
     int arrival_time = std::max(intervention_i.start_window + intervention_i.duration + instance.time_matrix[i][j], intervention_j.start_window);
+    // An ambiguous intervention cannot be done during the lunch break, we wait for the afternoon
+    if (intervention_j.is_ambiguous && arrival_time < MID_DAY && arrival_time + intervention_j.duration > MID_DAY){
+        arrival_time = MID_DAY;
+    }
 
     bool is_feasible = arrival_time + intervention_j.duration <= intervention_j.end_window;
 
@@ -77,6 +166,26 @@ bool is_edge_feasible(int i, int j, const Instance& instance){
     return is_feasible;
 }
 
+void compute_feasible_arcs(Instance& instance){
+    int n_nodes = instance.nodes.size();
+    // Each node's successors are computed in parallel, then concatenated
+    std::vector<std::vector<int>> node_successors(n_nodes);
+    parallel_for(n_nodes, [&](int i){
+        for (int j = 0; j < instance.number_interventions; j++){
+            if (i != j && is_edge_feasible(i, j, instance)){
+                node_successors[i].push_back(j);
+            }
+        }
+    });
+    instance.successors_start.assign(n_nodes + 1, 0);
+    instance.successors.clear();
+    for (int i = 0; i < n_nodes; i++){
+        instance.successors.insert(instance.successors.end(), node_successors[i].begin(), node_successors[i].end());
+        instance.successors_start[i + 1] = instance.successors.size();
+    }
+}
+
+
 void check_triangular_inequality(const Instance& instance) {
     using std::cout, std::endl;
     // First, we check that the distance matrix verifies the triangular inequality
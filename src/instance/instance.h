@@ -6,6 +6,7 @@
 #include <set>
 
 #include "instance/constants.h"
+#include "instance/dense_matrix.h"
 
 inline constexpr int KEEP_NON_COVERED = 0;
 inline constexpr int KEEP_COVERED = 1;
@@ -33,6 +34,10 @@ struct Node {
     std::map<std::string, int> quantities;
     // Skills required to perform the intervention (left empty for warehouses) (counting the number of technicians needed with each skill)
     std::map<std::string, int> required_skills;
+    // Dense versions of quantities and required_skills, indexed by the capacities and skills labels of the instance
+    // (filled by index_labels, a label missing from the maps has a value of 0)
+    std::vector<int> quantity_values;
+    std::vector<int> required_skill_counts;
     // Position information
     std::pair<double, double> position;
 
@@ -100,11 +105,19 @@ struct Vehicle {
     // (indexes with respect to the nodes std::vector in the instance)
     std::vector<int> interventions;
     // Reverse index of the interventions (from the nodes std::vector to the interventions vector)
-    std::map<int, int> reverse_interventions;
+    // reverse_interventions[i] is -1 if the vehicle cannot do intervention i
+    std::vector<int> reverse_interventions;
+    // Same interventions as a bitset, 64 interventions per word (used for the Hamming distances between vehicles)
+    std::vector<uint64_t> interventions_bits;
     // Index of the depot in the nodes std::vector
     int depot;
     std::map<std::string, int> capacities;
     double cost;
+    // Dense versions of skills and capacities, indexed by the skills and capacities labels of the instance (filled by index_labels)
+    std::vector<int> skill_counts;
+    std::vector<int> capacity_values;
+    // Arcs (i, j) the vehicle can not use, as indexes in the nodes std::vector (set by the branching, see branching_instance)
+    std::set<std::pair<int, int>> forbidden_arcs;
 
     // Empty constructor
     Vehicle(){}
@@ -115,7 +128,7 @@ struct Vehicle {
         std::vector<std::string> technicians,
         std::map<std::string, int> skills,
         std::vector<int> interventions,
-        std::map<int, int> reverse_interventions,
+        std::vector<int> reverse_interventions,
         int depot,
         std::map<std::string, int> capacities,
         double cost
@@ -131,6 +144,10 @@ struct Vehicle {
         {}
 };
 
+// Set the interventions of a vehicle, along with their reverse index and bitset
+// The interventions are indexes in [0, n_interventions)
+void set_vehicle_interventions(Vehicle& vehicle, std::vector<int> interventions, int n_interventions);
+
 // Generate a new vehicle from an existing one
 // @param mode : KEEP_NON_COVERED or KEEP_COVERED
 //
@@ -159,13 +176,20 @@ struct Instance {
     std::vector<Vehicle> vehicles;
     // Different capacities considered
     std::vector<std::string> capacities_labels;
+    // Different skills required by the interventions or owned by the technicians
+    std::vector<std::string> skills_labels;
     // time between the different nodes
-    std::vector<std::vector<int>> time_matrix;
+    TimeMatrix time_matrix;
     // distance between the different nodes
-    std::vector<std::vector<int>> distance_matrix;
+    DenseMatrix<int> distance_matrix;
     // Hamming similarity between vehicles (the lower the more similar)
-    std::vector<std::vector<int>> similarity_matrix;
-    // Instance constructor
+    DenseMatrix<int> similarity_matrix;
+    // Feasible successors of every node among the interventions, as a CSR adjacency (filled by compute_feasible_arcs)
+    // The successors of node i are successors[successors_start[i]] to successors[successors_start[i + 1] - 1], in increasing order
+    // Left empty until the time windows are final
+    std::vector<int> successors_start;
+    std::vector<int> successors;
+    // Instance constructor (the containers are moved into the instance)
     Instance(
         std::string name,
         int number_interventions,
@@ -177,9 +201,10 @@ struct Instance {
         std::vector<Node> nodes,
         std::vector<Vehicle> vehicles,
         std::vector<std::string> capacities_labels,
-        std::vector<std::vector<int>> time_matrix,
-        std::vector<std::vector<int>> distance_matrix,
-        std::vector<std::vector<int>> similarity_matrix
+        std::vector<std::string> skills_labels,
+        TimeMatrix time_matrix,
+        DenseMatrix<int> distance_matrix,
+        DenseMatrix<int> similarity_matrix
     ) :
         name(name),
         number_interventions(number_interventions),
@@ -188,28 +213,46 @@ struct Instance {
         cost_per_km(cost_per_km),
         technician_cost(technician_cost),
         M(M),
-        nodes(nodes),
-        vehicles(vehicles),
-        capacities_labels(capacities_labels),
-        time_matrix(time_matrix),
-        distance_matrix(distance_matrix),
-        similarity_matrix(similarity_matrix)
+        nodes(std::move(nodes)),
+        vehicles(std::move(vehicles)),
+        capacities_labels(std::move(capacities_labels)),
+        skills_labels(std::move(skills_labels)),
+        time_matrix(std::move(time_matrix)),
+        distance_matrix(std::move(distance_matrix)),
+        similarity_matrix(std::move(similarity_matrix))
         {}
 };
 
 
-bool is_symmetric(const std::vector<std::vector<int>>& matrix);
+template <typename T>
+bool is_symmetric(const DenseMatrix<T>& matrix);
+
+template <typename T>
+int symmetry_gap(const DenseMatrix<T>& matrix);
 
-int symmetry_gap(const std::vector<std::vector<int>>& matrix);
+// Turn the skills and capacities labels into dense indexes
+// Fills the dense vectors of the nodes and vehicles, indexed by capacities_labels and by the returned skills labels (sorted)
+std::vector<std::string> index_labels(std::vector<Node>& nodes, std::vector<Vehicle>& vehicles, const std::vector<std::string>& capacities_labels);
 
+// Checks that the vehicle has enough technicians with each skill required by the intervention
+// (uses the dense skill counts, see index_labels)
 bool can_do_intervention(const Node& intervention, const Vehicle& vehicle);
 
+// Compatibility between the first n_interventions nodes and the vehicles
+// compatible[i][v] is 1 if vehicle v can do intervention i (same result as can_do_intervention)
+DenseMatrix<uint8_t> compatibility_matrix(const std::vector<Node>& nodes, int n_interventions, const std::vector<Vehicle>& vehicles);
+
 
 // Checks wether intervention j can follow intervention i (is the edge i->j feasible?)
-// We check this by looking at the time window of the interventions
+// We check this by looking at the time window of the interventions (and at the lunch break if j is ambiguous)
 bool is_edge_feasible(int i, int j, const Instance& instance);
 
 
+// Computes the feasible successors index of the instance (see Instance::successors)
+// Must be called again whenever the time windows change
+void compute_feasible_arcs(Instance& instance);
+
+
 // Check the triangular inequality for the distance and time matrices
 void check_triangular_inequality(const Instance& instance);
 
@@ -0,0 +1,349 @@
+#include "instance_cache.h"
+
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::vector, std::string, std::map;
+
+// Layout of the file : header, then the fields of the instance in a fixed order
+// Integers are stored as int32, reals as double, strings and containers are prefixed by their size
+// The matrices are stored row after row, as number_nodes * number_nodes int32
+inline constexpr char CACHE_MAGIC[8] = {'T', 'R', 'C', 'G', 'I', 'N', 'S', 'T'};
+inline constexpr int32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[8];
+    int32_t version;
+    int32_t padding;
+    int64_t source_size;
+    int64_t source_time;
+};
+
+
+// Size and modification time of the source file, identifying its content
+std::pair<int64_t, int64_t> source_signature(const string& source_file){
+    namespace fs = std::filesystem;
+    std::error_code error;
+    auto size = fs::file_size(source_file, error);
+    if (error) {
+        return {-1, -1};
+    }
+    auto time = fs::last_write_time(source_file, error);
+    if (error) {
+        return {-1, -1};
+    }
+    return {static_cast<int64_t>(size), static_cast<int64_t>(time.time_since_epoch().count())};
+}
+
+
+string instance_cache_path(const string& filename, int n_interventions, int n_vehicles){
+    return filename + ".i" + std::to_string(n_interventions) + ".v" + std::to_string(n_vehicles) + ".cache";
+}
+
+
+// Sequential writer on a binary stream
+struct CacheWriter {
+    std::ofstream& out;
+
+    template <typename T>
+    void pod(const T& value){
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void integer(int value){
+        pod(static_cast<int32_t>(value));
+    }
+    void text(const string& value){
+        integer(value.size());
+        out.write(value.data(), value.size());
+    }
+    void texts(const vector<string>& values){
+        integer(values.size());
+        for (const string& value : values){
+            text(value);
+        }
+    }
+    void integers(const vector<int>& values){
+        integer(values.size());
+        for (int value : values){
+            integer(value);
+        }
+    }
+    void counts(const map<string, int>& values){
+        integer(values.size());
+        for (const auto& [key, value] : values){
+            text(key);
+            integer(value);
+        }
+    }
+    template <typename T>
+    void matrix(const DenseMatrix<T>& values){
+        for (int i = 0; i < values.rows(); i++){
+            for (int j = 0; j < values.cols(); j++){
+                integer(values[i][j]);
+            }
+        }
+    }
+};
+
+
+// Sequential reader on a memory mapped buffer
+// Every read is bound checked, and sets failed when going past the end of the buffer
+struct CacheReader {
+    const char* data;
+    size_t size;
+    size_t position = 0;
+    bool failed = false;
+
+    template <typename T>
+    T pod(){
+        T value{};
+        if (failed || position + sizeof(T) > size){
+            failed = true;
+            return value;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+    int integer(){
+        return pod<int32_t>();
+    }
+    // Reads a size, checking that at least size elements of element_size bytes remain
+    int length(size_t element_size){
+        int n = integer();
+        if (n < 0 || position + n * element_size > size){
+            failed = true;
+            return 0;
+        }
+        return n;
+    }
+    string text(){
+        int n = length(1);
+        string value(data + position, n);
+        position += n;
+        return value;
+    }
+    vector<string> texts(){
+        int n = length(sizeof(int32_t));
+        vector<string> values;
+        values.reserve(n);
+        for (int i = 0; i < n && !failed; i++){
+            values.push_back(text());
+        }
+        return values;
+    }
+    vector<int> integers(){
+        int n = length(sizeof(int32_t));
+        vector<int> values(n);
+        for (int i = 0; i < n; i++){
+            values[i] = integer();
+        }
+        return values;
+    }
+    map<string, int> counts(){
+        int n = length(2 * sizeof(int32_t));
+        map<string, int> values;
+        for (int i = 0; i < n && !failed; i++){
+            string key = text();
+            values[key] = integer();
+        }
+        return values;
+    }
+    template <typename T>
+    DenseMatrix<T> matrix(int n){
+        if (n < 0 || position + (size_t) n * n * sizeof(int32_t) > size){
+            failed = true;
+            return {};
+        }
+        DenseMatrix<T> values(n, n);
+        for (int i = 0; i < n; i++){
+            if constexpr (sizeof(T) == sizeof(int32_t)){
+                std::memcpy(values[i], data + position, n * sizeof(int32_t));
+                position += n * sizeof(int32_t);
+            } else {
+                for (int j = 0; j < n; j++){
+                    values[i][j] = integer();
+                }
+            }
+        }
+        return values;
+    }
+};
+
+
+bool write_instance_cache(const Instance& instance, const string& cache_file, const string& source_file){
+    auto [source_size, source_time] = source_signature(source_file);
+    if (source_size < 0){
+        return false;
+    }
+    // Write into a temporary file first, so that concurrent runs never read a partial cache
+    string tmp_file = cache_file + ".tmp" + std::to_string(getpid());
+    std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!out){
+        return false;
+    }
+    CacheWriter writer{out};
+
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.source_size = source_size;
+    header.source_time = source_time;
+    writer.pod(header);
+
+    writer.integer(instance.number_interventions);
+    writer.integer(instance.number_warehouses);
+    writer.integer(instance.number_vehicles);
+    writer.pod(instance.cost_per_km);
+    writer.pod(instance.technician_cost);
+    writer.texts(instance.capacities_labels);
+
+    writer.integer(instance.nodes.size());
+    for (const Node& node : instance.nodes){
+        writer.text(node.id);
+        writer.integer(node.node_id);
+        writer.integer(node.is_intervention);
+        writer.integer(node.duration);
+        writer.integer(node.start_window);
+        writer.integer(node.end_window);
+        // Only defined for the interventions
+        writer.integer(node.is_intervention && node.is_ambiguous);
+        writer.counts(node.quantities);
+        writer.counts(node.required_skills);
+        writer.pod(node.position.first);
+        writer.pod(node.position.second);
+    }
+
+    writer.integer(instance.vehicles.size());
+    for (const Vehicle& vehicle : instance.vehicles){
+        writer.integer(vehicle.id);
+        writer.texts(vehicle.technicians);
+        writer.counts(vehicle.skills);
+        // The reverse index and the bitset are rebuilt when reading
+        writer.integers(vehicle.interventions);
+        writer.integer(vehicle.depot);
+        writer.counts(vehicle.capacities);
+        writer.pod(vehicle.cost);
+    }
+
+    writer.matrix(instance.time_matrix);
+    writer.matrix(instance.distance_matrix);
+
+    out.close();
+    if (!out){
+        std::filesystem::remove(tmp_file);
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(tmp_file, cache_file, error);
+    return !error;
+}
+
+
+std::optional<Instance> read_instance_cache(const string& cache_file, const string& source_file, const string& instance_name){
+    int fd = open(cache_file.c_str(), O_RDONLY);
+    if (fd < 0){
+        return std::nullopt;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < (off_t) sizeof(CacheHeader)){
+        close(fd);
+        return std::nullopt;
+    }
+    size_t size = file_stat.st_size;
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED){
+        return std::nullopt;
+    }
+    CacheReader reader{static_cast<const char*>(mapped), size};
+
+    // The cache is only used if it was built by this version, from the current source file
+    CacheHeader header = reader.pod<CacheHeader>();
+    auto [source_size, source_time] = source_signature(source_file);
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.source_size != source_size ||
+        header.source_time != source_time){
+        munmap(mapped, size);
+        return std::nullopt;
+    }
+
+    int number_interventions = reader.integer();
+    int number_warehouses = reader.integer();
+    int number_vehicles = reader.integer();
+    double cost_per_km = reader.pod<double>();
+    double technician_cost = reader.pod<double>();
+    vector<string> capacities_labels = reader.texts();
+
+    vector<Node> nodes(reader.length(sizeof(int32_t)));
+    for (Node& node : nodes){
+        node.id = reader.text();
+        node.node_id = reader.integer();
+        node.is_intervention = reader.integer();
+        node.duration = reader.integer();
+        node.start_window = reader.integer();
+        node.end_window = reader.integer();
+        node.is_ambiguous = reader.integer();
+        node.quantities = reader.counts();
+        node.required_skills = reader.counts();
+        node.position.first = reader.pod<double>();
+        node.position.second = reader.pod<double>();
+        if (reader.failed) break;
+    }
+
+    vector<Vehicle> vehicles(reader.length(sizeof(int32_t)));
+    for (Vehicle& vehicle : vehicles){
+        vehicle.id = reader.integer();
+        vehicle.technicians = reader.texts();
+        vehicle.skills = reader.counts();
+        vector<int> interventions = reader.integers();
+        // Out of range interventions would corrupt the reverse index
+        for (int i : interventions){
+            if (i < 0 || i >= number_interventions){
+                reader.failed = true;
+            }
+        }
+        if (reader.failed) break;
+        set_vehicle_interventions(vehicle, std::move(interventions), number_interventions);
+        vehicle.depot = reader.integer();
+        vehicle.capacities = reader.counts();
+        vehicle.cost = reader.pod<double>();
+        if (reader.failed) break;
+    }
+
+    TimeMatrix time_matrix = reader.matrix<TimeMatrix::value_type>(nodes.size());
+    DenseMatrix<int> distance_matrix = reader.matrix<int>(nodes.size());
+
+    bool valid = !reader.failed && reader.position == size;
+    munmap(mapped, size);
+    if (!valid){
+        return std::nullopt;
+    }
+    // The dense skills and capacities are rebuilt from the maps
+    vector<string> skills_labels = index_labels(nodes, vehicles, capacities_labels);
+
+    return Instance(
+        instance_name,
+        number_interventions,
+        number_warehouses,
+        number_vehicles,
+        cost_per_km,
+        technician_cost,
+        0,
+        std::move(nodes),
+        std::move(vehicles),
+        std::move(capacities_labels),
+        std::move(skills_labels),
+        std::move(time_matrix),
+        std::move(distance_matrix),
+        {}
+    );
+}
@@ -0,0 +1,19 @@
+// Binary cache of a parsed instance, to skip the JSON parsing on repeated runs
+#pragma once
+#include <string>
+#include <optional>
+#include "instance/instance.h"
+
+// Path of the cache file of an instance file, for a given number of interventions and vehicles
+std::string instance_cache_path(const std::string& filename, int n_interventions, int n_vehicles);
+
+// Write the instance into a binary cache file
+// The size and modification time of the source file are stored, to detect outdated caches
+// Derived data (M, similarity matrix, dense skills and capacities) is not stored
+// Returns false if the file could not be written
+bool write_instance_cache(const Instance& instance, const std::string& cache_file, const std::string& source_file);
+
+// Read an instance from a binary cache file (memory mapped)
+// Returns an empty optional if the cache does not exist, is invalid or is older than the source file
+// M and the similarity matrix are left empty
+std::optional<Instance> read_instance_cache(const std::string& cache_file, const std::string& source_file, const std::string& instance_name);
@@ -0,0 +1,33 @@
+// Parallel loop over a range of indexes, used to build the instances
+#pragma once
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+
+// Calls f(i) for every i in [0, n), splitting the range into contiguous blocks, one per hardware thread
+// f must be safe to call concurrently for different indexes
+template <typename F>
+void parallel_for(int n, F f){
+    int n_threads = std::max(1, std::min<int>(std::thread::hardware_concurrency(), n));
+    if (n_threads <= 1){
+        for (int i = 0; i < n; i++){
+            f(i);
+        }
+        return;
+    }
+    std::vector<std::thread> threads;
+    int block = (n + n_threads - 1) / n_threads;
+    for (int t = 0; t < n_threads; t++){
+        int begin = t * block;
+        int end = std::min(n, begin + block);
+        threads.push_back(std::thread([&f, begin, end](){
+            for (int i = begin; i < end; i++){
+                f(i);
+            }
+        }));
+    }
+    for (auto& thread : threads){
+        thread.join();
+    }
+}
@@ -1,6 +1,8 @@
 #include "parser.h"
 
 #include "instance/constants.h"
+#include "instance/instance_cache.h"
+#include "instance/parallel.h"
 #include "clustering/clustering.h"
 #include "../../nlohmann/json.hpp"
 
@@ -31,7 +33,7 @@ int convert_to_relative_time(int end_time){
 }
 
 // Parse a JSON object into an Node object
-Node parse_intervention(json data){
+Node parse_intervention(const json& data){
     string id = data.at("id");
     int node_id = data.at("node_id");
     int duration = data.at("duration");
@@ -56,7 +58,7 @@ Node parse_intervention(json data){
 
 
 // Parse a JSON object into a Node object
-Node parse_warehouse(json data){
+Node parse_warehouse(const json& data){
     int node_id = data.at("node_id");
     string ope_base = data.at("ope_base");
     // The position is given as a pair of coordinates 
@@ -71,7 +73,7 @@ Node parse_warehouse(json data){
 
 
 // Parse a technician JSON object into a Technician object
-Technician parse_technician(json data){
+Technician parse_technician(const json& data){
     string id = data.at("id");
     set<string> skills = set<string>();
     for (const auto &skill : data.at("skills")){
@@ -84,18 +86,180 @@ Technician parse_technician(json data){
 
 
 
+// SAX handler extracting the distance and time matrices of the file, restricted to the nodes of the instance
+// The raw matrices are indexed by node_id, the extracted ones by the index of the node in the instance
+// Only loc_manager.matrix.distance and loc_manager.matrix.time are looked at, everything else is skipped
+class MatrixExtractor : public nlohmann::json_sax<json> {
+public:
+    MatrixExtractor(const vector<Node>& nodes, DenseMatrix<int>& distance_matrix, TimeMatrix& time_matrix) :
+        distance_matrix(distance_matrix), time_matrix(time_matrix) {
+        for (int i = 0; i < nodes.size(); i++){
+            if (nodes[i].node_id >= indexes.size()){
+                indexes.resize(nodes[i].node_id + 1);
+            }
+            indexes[nodes[i].node_id].push_back(i);
+        }
+        distance_matrix = DenseMatrix<int>(nodes.size(), nodes.size(), 0);
+        time_matrix = TimeMatrix(nodes.size(), nodes.size(), 0);
+    }
+
+    // Throws if a node_id is out of the rows or columns of one of the raw matrices
+    void check_bounds(){
+        for (int m = 0; m < 2; m++){
+            if (rows_read[m] < indexes.size() || min_columns_read[m] < indexes.size()){
+                throw std::out_of_range(std::string("Node id not found in the ") + (m == 0 ? "distance" : "time") + " matrix");
+            }
+        }
+    }
+
+    bool number_integer(number_integer_t value) override {return number(value);}
+    bool number_unsigned(number_unsigned_t value) override {return number(value);}
+    bool number_float(number_float_t value, const string_t&) override {return number(value);}
+    bool null() override {return scalar();}
+    bool boolean(bool) override {return scalar();}
+    bool string(string_t&) override {return scalar();}
+    bool binary(binary_t&) override {return scalar();}
+
+    bool start_object(std::size_t) override {
+        containers.push_back(OBJECT);
+        keys.emplace_back();
+        return true;
+    }
+    bool key(string_t& value) override {
+        // Only the keys on the path to the matrices are kept
+        if (containers.size() <= 3){
+            keys.back() = value;
+        }
+        return true;
+    }
+    bool end_object() override {
+        containers.pop_back();
+        keys.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (target == NO_MATRIX && is_matrix_path()){
+            target = keys[2] == "distance" ? DISTANCE : TIME;
+            matrix_depth = containers.size() + 1;
+            row = -1;
+        } else if (target != NO_MATRIX && containers.size() == matrix_depth){
+            // New row of the raw matrix
+            row++;
+            column = -1;
+        }
+        containers.push_back(ARRAY);
+        return true;
+    }
+    bool end_array() override {
+        containers.pop_back();
+        if (target != NO_MATRIX && containers.size() == matrix_depth){
+            min_columns_read[target] = std::min(min_columns_read[target], column + 1);
+        } else if (target != NO_MATRIX && containers.size() == matrix_depth - 1){
+            rows_read[target] = row + 1;
+            target = NO_MATRIX;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    enum Container {OBJECT, ARRAY};
+    static constexpr int NO_MATRIX = -1;
+    static constexpr int DISTANCE = 0;
+    static constexpr int TIME = 1;
+
+    DenseMatrix<int>& distance_matrix;
+    TimeMatrix& time_matrix;
+    // indexes[node_id] : indexes of the nodes of the instance with this node_id
+    vector<vector<int>> indexes;
+
+    vector<Container> containers;
+    vector<std::string> keys;
+
+    // Matrix being read, depth of its rows and position in the raw matrix
+    int target = NO_MATRIX;
+    int matrix_depth = 0;
+    int row = -1;
+    int column = -1;
+    int rows_read[2] = {0, 0};
+    int min_columns_read[2] = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+
+    // Whether the next array is loc_manager.matrix.distance or loc_manager.matrix.time
+    bool is_matrix_path(){
+        return containers.size() == 3 && containers[0] == OBJECT && containers[1] == OBJECT && containers[2] == OBJECT &&
+            keys[0] == "loc_manager" && keys[1] == "matrix" && (keys[2] == "distance" || keys[2] == "time");
+    }
+
+    template <typename T>
+    bool number(T value){
+        if (target == NO_MATRIX || containers.size() != matrix_depth + 1){
+            return true;
+        }
+        column++;
+        if (row >= indexes.size() || column >= indexes.size() || indexes[row].empty() || indexes[column].empty()){
+            return true;
+        }
+        if (target == DISTANCE){
+            store(distance_matrix, value);
+        } else {
+            store(time_matrix, value);
+        }
+        return true;
+    }
+    template <typename M, typename T>
+    void store(DenseMatrix<M>& matrix, T value){
+        double checked_value = value;
+        if (checked_value < std::numeric_limits<M>::min() || checked_value > std::numeric_limits<M>::max()){
+            throw std::out_of_range("Matrix entry " + std::to_string(value) + " does not fit in the matrix storage");
+        }
+        for (int i : indexes[row]){
+            for (int j : indexes[column]){
+                matrix[i][j] = static_cast<M>(value);
+            }
+        }
+    }
+    bool scalar(){
+        if (target != NO_MATRIX && containers.size() == matrix_depth + 1){
+            column++;
+        }
+        return true;
+    }
+};
+
+
 // Parse a JSON file to return a Instance object
-Instance parse_file(string filename, string instance_name, int nb_interventions, int n_vehicles, bool verbose){
+Instance parse_file(string filename, string instance_name, int nb_interventions, int n_vehicles, bool verbose, bool use_cache){
+    // Repeated runs on the same file and sizes load the binary cache instead
+    string cache_file = instance_cache_path(filename, nb_interventions, n_vehicles);
+    if (use_cache){
+        std::optional<Instance> cached_instance = read_instance_cache(cache_file, filename, instance_name);
+        if (cached_instance){
+            if (verbose){
+                cout << "Loaded instance from cache " << cache_file << endl;
+            }
+            cached_instance->similarity_matrix = compute_similarity_matrix(cached_instance->vehicles);
+            cached_instance->M = compute_M_perV(*cached_instance);
+            return *cached_instance;
+        }
+    }
+
     if (verbose){
         cout << "Parsing file " << filename << endl;
     }
 
-    // Read the JSON file
+    // Read the JSON file, without the distance and time matrices
+    // They cover every node of the agency, and are read afterwards for the nodes of the instance only
     ifstream f(filename);
-    json data = json::parse(f);
+    json data = json::parse(f, [](int depth, json::parse_event_t event, json& parsed){
+        return !(event == json::parse_event_t::key && depth == 2 && parsed == "matrix");
+    });
 
     // Get the main constants
-    json constants = data.at("const_manager");
+    const json& constants = data.at("const_manager");
     double cost_per_km = constants.at("km_cost");
     double tech_cost = constants.at("tech_cost");
     int number_ressources = constants.at("capacities_size");
@@ -122,18 +286,13 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
     }
 
 
-    // Get the matrices of distance and time
-    json loc_manager = data.at("loc_manager");
-    vector<vector<int>> distance_matrix_raw = loc_manager.at("matrix").at("distance");
-    vector<vector<int>> time_matrix_raw = loc_manager.at("matrix").at("time");
-
     // For the interventions and warehouse, we wil put them into a single vector
     // Also build a map from intervention / warehouse id to index in the vector
     vector<Node> nodes = vector<Node>();
     map<string, int> node_id_to_index = map<string, int>();
 
     // Get the n_interventions interventions
-    vector<json> interventions_data = data.at("step_manager").at("interventions");
+    const json& interventions_data = data.at("step_manager").at("interventions");
     if (nb_interventions == -1){
         nb_interventions = interventions_data.size();
     }
@@ -147,7 +306,7 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
 
 
     // Get the warehouses and add them to the nodes
-    vector<json> warehouses_data = data.at("step_manager").at("warehouses");
+    const json& warehouses_data = data.at("step_manager").at("warehouses");
     for (int i = 0; i < warehouses_data.size(); i++){
         Node warehouse = parse_warehouse(warehouses_data[i]);
         // Time window for the warehouse is the whole day
@@ -167,21 +326,20 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
 
     // Build the time and distance matrix for the nodes :
     // time_matrix[i][j] is the time to go from node i to node j
-    vector<vector<int>> time_matrix = vector<vector<int>>(nodes.size(), vector<int>(nodes.size(), 0));
-    vector<vector<int>> distance_matrix = vector<vector<int>>(nodes.size(), vector<int>(nodes.size(), 0));
-    for (int i = 0; i < nodes.size(); i++){
-        for (int j = 0; j < nodes.size(); j++){
-            // The distance and time matrices are indexed by the node_id
-            int node1_id = nodes[i].node_id;
-            int node2_id = nodes[j].node_id;
-            distance_matrix[i][j] = distance_matrix_raw.at(node1_id).at(node2_id);
-            time_matrix[i][j] = time_matrix_raw.at(node1_id).at(node2_id);
-        }
+    // The raw matrices are indexed by the node_id, they are streamed from the file with only the needed entries kept
+    TimeMatrix time_matrix;
+    DenseMatrix<int> distance_matrix;
+    MatrixExtractor extractor(nodes, distance_matrix, time_matrix);
+    f.clear();
+    f.seekg(0);
+    if (!json::sax_parse(f, &extractor)){
+        throw std::runtime_error("Could not read the matrices of " + filename);
     }
+    extractor.check_bounds();
 
 
     // Before building the teams, we put all the technicians into a dictionary for easy access
-    vector<json> technicians_data = data.at("tech_manager").at("technicians");
+    const json& technicians_data = data.at("tech_manager").at("technicians");
     map<string, Technician> technicians = map<string, Technician>();
     for (int i = 0; i < technicians_data.size(); i++){
         Technician tech = parse_technician(technicians_data[i]);
@@ -264,7 +422,7 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
         }
         // Vehicle cost is the sum of the cost of each technician in the team
         double vehicle_cost = tech_cost * team_ids.size();
-        vehicles.push_back(Vehicle(v, team_ids, skills, vector<int>(), map<int, int>(), depot, capacities, vehicle_cost));
+        vehicles.push_back(Vehicle(v, team_ids, skills, vector<int>(), vector<int>(), depot, capacities, vehicle_cost));
     }
 
     // Print the number of technicians, teams and vehicles
@@ -274,46 +432,45 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
         cout << " - Number of vehicles: " << vehicles.size() << endl;
     }
 
-    // We now build a cross reference matrix between interventions and vehicles : has_skill[i][j] is true if vehicle j has the skills to do intervention i
-    vector<vector<bool>> has_skill = vector<vector<bool>>(nb_interventions, vector<bool>(vehicles.size(), false));
-    for (int i = 0; i < nb_interventions; i++){
-        for (int v = 0; v < vehicles.size(); v++){
-            // We must ensure that the vehicle has enough technicians with each skill to do the intervention
-            bool can_do = can_do_intervention(nodes[i], vehicles[v]);
-            has_skill[i][v] = can_do;
-        }
-    }
+    // Turn the skills and capacities into dense indexes, used by the compatibility checks and the pricing problems
+    vector<string> skills_labels = index_labels(nodes, vehicles, ressources);
+
+    // We now build a cross reference matrix between interventions and vehicles : has_skill[i][v] is true if vehicle v has the skills to do intervention i
+    DenseMatrix<uint8_t> has_skill = compatibility_matrix(nodes, nb_interventions, vehicles);
 
-    // And we can add references to the interventions that each vehicle can do
-    for (int v = 0; v < vehicles.size(); v++){
+    // And we can add references to the interventions that each vehicle can do (one vehicle per thread)
+    parallel_for(vehicles.size(), [&](int v){
+        vector<int> interventions;
         for (int i = 0; i < nb_interventions; i++){
             if (has_skill[i][v]){
-                vehicles[v].interventions.push_back(i);
-                vehicles[v].reverse_interventions[i] = vehicles[v].interventions.size() - 1;
+                interventions.push_back(i);
             }
         }
-    }
+        set_vehicle_interventions(vehicles[v], std::move(interventions), nb_interventions);
+    });
 
     // Compute the similarity matrix between vehicles
-    vector<vector<int>> similarity_matrix = compute_similarity_matrix(vehicles);
+    DenseMatrix<int> similarity_matrix = compute_similarity_matrix(vehicles);
 
 
 
-    // We can now build the instance object
+    // We can now build the instance object (the containers are moved into it)
+    int nb_vehicles = vehicles.size();
     auto instance = Instance(
         instance_name,
         nb_interventions,
         nb_warehouses,
-        vehicles.size(),
+        nb_vehicles,
         cost_per_km,
         tech_cost,
         0,
-        nodes,
-        vehicles,
-        ressources,
-        time_matrix,
-        distance_matrix,
-        similarity_matrix
+        std::move(nodes),
+        std::move(vehicles),
+        std::move(ressources),
+        std::move(skills_labels),
+        std::move(time_matrix),
+        std::move(distance_matrix),
+        std::move(similarity_matrix)
     );
 
     instance.M = compute_M_perV(instance);
@@ -322,6 +479,10 @@ Instance parse_file(string filename, string instance_name, int nb_interventions,
         cout << "Big M value: " << instance.M << endl;
     }
 
+    if (use_cache && !write_instance_cache(instance, cache_file, filename)){
+        cout << "Could not write the instance cache " << cache_file << endl;
+    }
+
     return instance;
 }
     
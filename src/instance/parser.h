@@ -9,4 +9,5 @@
 // @param n_interventions : the number of interventions to keep (if -1, keep all)
 // @param n_vehicles : the number of vehicles to keep (if -1, keep all)
 // @param verbose : whether to print the instance information
-Instance parse_file(std::string filename, std::string instance_name, int n_interventions = -1, int n_vehicles = -1, bool verbose = false);
\ No newline at end of file
+// @param use_cache : whether to load the instance from its binary cache (see instance_cache.h), and to write it after parsing
+Instance parse_file(std::string filename, std::string instance_name, int n_interventions = -1, int n_vehicles = -1, bool verbose = false, bool use_cache = false);
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "preprocessing.h"
+#include "clustering/clustering.h"
+
 #include <iostream>
+#include <algorithm>
+#include <set>
 
 using std::cout, std::endl;
 
@@ -52,13 +56,143 @@ void preprocess_interventions(Instance &instance, bool verbose){
         }
     }
 
+    // Then, tighten the time windows and remove the interventions the vehicles cannot reach
+    auto [nb_tightened, nb_removed] = tighten_time_windows(instance);
+
+    // The time windows are now final, the feasible arcs can be indexed
+    compute_feasible_arcs(instance);
+
     // Print the informations
     if (verbose){
         cout << "Number of non-ambiguous interventions: " << nb_non_ambiguous << endl;
         cout << "Number of interventions that we could reduce the time window for: " << nb_reductions << endl;
         cout << "Number of ambiguous interventions: " << nb_ambiguous << endl;
+        cout << "Number of time windows tightened: " << nb_tightened << endl;
+        cout << "Number of (vehicle, intervention) pairs removed: " << nb_removed << endl;
+        cout << "Number of feasible arcs: " << instance.successors.size() << endl;
         cout << "----------------------------------------" << endl;
     }
 
     return;
-}
\ No newline at end of file
+}
+
+
+// Applies the lunch rule to the time window of a short intervention
+// If it can no longer be done in the morning (or in the afternoon), the time window is reduced to the other half day
+void apply_lunch_rule(Node& intervention){
+    if (!intervention.is_ambiguous){
+        return;
+    }
+    bool can_morning = intervention.start_window + intervention.duration <= MID_DAY;
+    bool can_afternoon = intervention.end_window >= MID_DAY + intervention.duration;
+    if (can_morning && !can_afternoon){
+        intervention.end_window = MID_DAY;
+        intervention.is_ambiguous = false;
+    } else if (!can_morning && can_afternoon){
+        intervention.start_window = MID_DAY;
+        intervention.is_ambiguous = false;
+    }
+}
+
+
+// Earliest start of an intervention, given a lower bound on its arrival time
+int earliest_start(const Node& intervention, int arrival){
+    int start = std::max(intervention.start_window, arrival);
+    // Wait for the end of the lunch break rather than working through it
+    if (intervention.is_ambiguous && start < MID_DAY && start + intervention.duration > MID_DAY){
+        start = MID_DAY;
+    }
+    return start;
+}
+
+
+std::pair<int, int> tighten_time_windows(Instance& instance){
+    using std::vector, std::min, std::max;
+    int n = instance.number_interventions;
+    vector<Node>& nodes = instance.nodes;
+    std::set<int> tightened;
+    int nb_removed = 0;
+
+    for (int iteration = 0; iteration < MAX_TIGHTENING_ITERATIONS; iteration++){
+        bool changed = false;
+
+        // Depots from which each intervention can be done
+        vector<std::set<int>> depots(n);
+        for (const Vehicle& vehicle : instance.vehicles){
+            for (int i : vehicle.interventions){
+                depots[i].insert(vehicle.depot);
+            }
+        }
+
+        // Earliest arrival from a feasible predecessor, and latest departure to a feasible successor
+        // The travel times may not verify the triangular inequality, so every predecessor and successor is looked at
+        vector<int> predecessor_arrival(n, END_DAY);
+        vector<int> successor_departure(n, 0);
+        for (int i = 0; i < n; i++){
+            if (depots[i].empty()) continue;
+            for (int j = 0; j < n; j++){
+                if (j == i || depots[j].empty()) continue;
+                if (is_edge_feasible(j, i, instance)){
+                    predecessor_arrival[i] = min(predecessor_arrival[i], nodes[j].start_window + nodes[j].duration + instance.time_matrix[j][i]);
+                }
+                if (is_edge_feasible(i, j, instance)){
+                    successor_departure[i] = max(successor_departure[i], nodes[j].end_window - nodes[j].duration - instance.time_matrix[i][j]);
+                }
+            }
+        }
+
+        // Remove from each vehicle the interventions it cannot fit between leaving and coming back to its depot
+        for (Vehicle& vehicle : instance.vehicles){
+            int depot = vehicle.depot;
+            vector<int> reachable;
+            for (int i : vehicle.interventions){
+                int arrival = min((int) instance.time_matrix[depot][i], predecessor_arrival[i]);
+                int departure = max(END_DAY - instance.time_matrix[i][depot], successor_departure[i]);
+                if (earliest_start(nodes[i], arrival) + nodes[i].duration <= min(nodes[i].end_window, departure)){
+                    reachable.push_back(i);
+                }
+            }
+            if (reachable.size() < vehicle.interventions.size()){
+                nb_removed += vehicle.interventions.size() - reachable.size();
+                set_vehicle_interventions(vehicle, std::move(reachable), n);
+                changed = true;
+            }
+        }
+
+        // Tighten the time windows on all the depots of the intervention
+        for (int i = 0; i < n; i++){
+            if (depots[i].empty()) continue;
+            Node& intervention = nodes[i];
+            int arrival = predecessor_arrival[i];
+            int departure = successor_departure[i];
+            for (int depot : depots[i]){
+                arrival = min(arrival, (int) instance.time_matrix[depot][i]);
+                departure = max(departure, END_DAY - instance.time_matrix[i][depot]);
+            }
+            int start_window = max(intervention.start_window, arrival);
+            int end_window = min(intervention.end_window, departure);
+            // An empty window means the intervention was removed from all its vehicles
+            if (start_window + intervention.duration > end_window){
+                continue;
+            }
+            if (start_window != intervention.start_window || end_window != intervention.end_window){
+                intervention.start_window = start_window;
+                intervention.end_window = end_window;
+                apply_lunch_rule(intervention);
+                tightened.insert(i);
+                changed = true;
+            }
+        }
+
+        if (!changed){
+            break;
+        }
+    }
+
+    // The similarity between vehicles depends on their interventions
+    if (nb_removed > 0){
+        instance.similarity_matrix = compute_similarity_matrix(instance.vehicles);
+    }
+
+    return {tightened.size(), nb_removed};
+}
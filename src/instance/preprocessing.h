@@ -8,4 +8,23 @@
 // i.e. if they can be done both fully in the morning and fully in the afternoon
 // If not, we reduce the time window to the morning or the afternoon
 // Print the number of interventions that we could reduce the time window for
-void preprocess_interventions(Instance &instance, bool verbose = false);
\ No newline at end of file
+// The time windows are then tightened (see tighten_time_windows)
+// Also computes the feasible successors index of the instance, on the final time windows
+void preprocess_interventions(Instance &instance, bool verbose = false);
+
+
+// Earliest start of an intervention, given a lower bound on its arrival time
+// Waits for the start of the time window, and for the end of the lunch break if the intervention is ambiguous
+int earliest_start(const Node& intervention, int arrival);
+
+
+// Maximum number of sweeps of tighten_time_windows
+inline constexpr int MAX_TIGHTENING_ITERATIONS = 10;
+
+// Iteratively tightens the time windows of the interventions, until no window changes :
+// - the start of an intervention is after the earliest arrival from a depot or from a feasible predecessor
+// - its end leaves enough time to reach a depot before END_DAY, or a feasible successor before its latest start
+// Only the depots of the vehicles able to do the intervention are considered, and the lunch rule is applied to the new windows
+// The interventions a vehicle cannot fit between leaving and coming back to its depot are removed from the vehicle
+// Returns the number of tightened time windows and the number of (vehicle, intervention) pairs removed
+std::pair<int, int> tighten_time_windows(Instance &instance);
@@ -2,6 +2,7 @@
 #include "instance/preprocessing.h"
 
 #include "master_problem/master.h"
+#include "master_problem/master_solver.h"
 #include "pricing_problem/subproblem.h"
 
 #include "algorithms/branch_and_price.h"
@@ -61,10 +62,16 @@ int main(int argc, char *argv[]){
 
     cout << "-----------------------------------" << endl;
     vector<Route> routes;
-    cout << "Initializing the routes with an empty route" << endl;
+    cout << "Initializing the routes with an empty route and the routes of the constructive heuristic" << endl;
     routes = vector<Route>();
     routes.push_back(EmptyRoute(instance.nodes.size()));
-    
+    // The heuristic routes form a feasible integer solution of the root node, used as the first incumbent
+    vector<Route> initial_routes = initial_routes_heuristic(instance, VERBOSE);
+    routes.insert(routes.end(), initial_routes.begin(), initial_routes.end());
+    IntegerSolution heuristic_solution = IntegerSolution(vector<int>(initial_routes.size(), 1), 0);
+    double heuristic_objective = compute_integer_objective(heuristic_solution, initial_routes, instance, false);
+    cout << "Objective value of the heuristic solution : " << heuristic_objective << endl;
+
 
     cout << "-----------------------------------" << endl;
 
@@ -85,11 +92,13 @@ int main(int argc, char *argv[]){
     }
     );
 
-    branch_and_price(
+    double best_objective = branch_and_price(
         instance,
         routes,
-        parameters
+        parameters,
+        heuristic_objective
         );
+    cout << "Objective value of the best solution : " << best_objective << endl;
 
     return 0;
 }
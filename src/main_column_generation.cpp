@@ -13,6 +13,7 @@
 
 #include "algorithms/column_generation.h"
 #include "algorithms/full_procedure.h"
+#include "algorithms/heuristics.h"
 
 #include "data_analysis/analysis.h"
 #include "data_analysis/export.h"
@@ -29,6 +30,8 @@
 
 inline constexpr int TIME_LIMIT = 60;
 inline constexpr bool VERBOSE = true;
+// Keep a binary cache of the parsed instances next to the JSON files
+inline constexpr bool USE_INSTANCE_CACHE = true;
 inline constexpr bool EXPORT_SOLUTION = true;
 
 
@@ -58,7 +61,7 @@ int main(int argc, char *argv[]){
         {"use_visited", true},
         {"bidirectional_DP", false},
         {"pathwyse_time_limit", 0.0},
-        {"switch_to_cyclic_price", true},
+        {"switch_to_cyclic_pricing", true},
         {"delta ", 50},
         {"solution_pool_size", 10},
         {"alpha", 0.5},
@@ -111,7 +114,7 @@ int main(int argc, char *argv[]){
         cout << "-----------------------------------" << endl;
         string filename = "../data/" + name + ".json";
         cout << "Parsing the instance " << name << " from " << filename << endl;
-        Instance instance = parse_file(filename, name, intervention_size, vehicle_size, false);
+        Instance instance = parse_file(filename, name, intervention_size, vehicle_size, false, USE_INSTANCE_CACHE);
 
         preprocess_interventions(instance);
         int exclude_from_linear_plot = 15;
@@ -154,6 +157,9 @@ int main(int argc, char *argv[]){
                 cout << "Starting the column generation algorithm" << endl;
                 parameters.max_resources_dominance = instance.capacities_labels.size() + 1;
                 instance.M = current_M;
+                // Seed the master problem with the routes of the constructive heuristic
+                vector<Route> initial_routes = initial_routes_heuristic(instance, true);
+                routes.insert(routes.end(), initial_routes.begin(), initial_routes.end());
 
                 CGResult result = full_cg_procedure(instance, routes, parameters);
 
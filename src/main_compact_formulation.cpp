@@ -8,6 +8,9 @@
 
 #include "data_analysis/analysis.h"
 
+#include "algorithms/full_procedure.h"
+#include "algorithms/parameters.h"
+
 #include "../nlohmann/json.hpp"
 
 #include <iostream>
@@ -22,6 +25,11 @@ inline constexpr int N_INTERVENTIONS = 25;
 
 inline constexpr int TIME_LIMIT = 1200;
 inline constexpr bool VERBOSE = true;
+// Keep a binary cache of the parsed instances next to the JSON files
+inline constexpr bool USE_INSTANCE_CACHE = true;
+// Also solve the compact model warm started by the column generation (see warm_started_compact_procedure)
+inline constexpr bool USE_WARM_START = false;
+inline constexpr int CG_TIME_LIMIT = 60;
 
 
 int main(int argc, char** argv) {
@@ -39,6 +47,13 @@ int main(int argc, char** argv) {
     std::array<string, 5> instances;
 
     map<string, map<string, double>> relaxed_values;
+    map<string, map<string, double>> warm_started_values;
+
+    ColumnGenerationParameters parameters = ColumnGenerationParameters({
+        {"time_limit", CG_TIME_LIMIT},
+        {"verbose", false},
+        {"compute_integer_solution", true}
+    });
 
     for (const auto& size : {"small", "medium", "large"}){
         if (size == "small"){
@@ -64,7 +79,7 @@ int main(int argc, char** argv) {
             cout << "-----------------------------------" << endl;
             string filename = "../data/" + name + ".json";
             cout << "Parsing the instance " << name << " from " << filename << endl;
-            Instance instance = parse_file(filename, name, intervention_size, vehicle_size, false);
+            Instance instance = parse_file(filename, name, intervention_size, vehicle_size, false, USE_INSTANCE_CACHE);
 
             preprocess_interventions(instance);
 
@@ -72,6 +87,12 @@ int main(int argc, char** argv) {
             CompactSolution<double> relaxed_solution = relaxed_compact_solver(instance, TIME_LIMIT, VERBOSE);
 
             relaxed_values[size][name] = relaxed_solution.objective_value;
+
+            // Solve the compact model from the integer solution of the column generation
+            if (USE_WARM_START){
+                CompactSolution<int> solution = warm_started_compact_procedure(instance, parameters, TIME_LIMIT);
+                warm_started_values[size][name] = solution.objective_value;
+            }
         }
     }
 
@@ -81,6 +102,13 @@ int main(int argc, char** argv) {
     relaxed_file << relaxed_json.dump(4);
     relaxed_file.close();
 
+    if (USE_WARM_START){
+        nlohmann::json warm_started_json = warm_started_values;
+        std::ofstream warm_started_file("../results/warm_started_values_compact.json");
+        warm_started_file << warm_started_json.dump(4);
+        warm_started_file.close();
+    }
+
 
 
     return 0;
@@ -0,0 +1,92 @@
+#include "instance/parser.h"
+#include "instance/preprocessing.h"
+
+#include "algorithms/rolling_horizon.h"
+#include "algorithms/parameters.h"
+
+#include "data_analysis/export.h"
+
+#include <iostream>
+#include <chrono>
+#include <format>
+#include <filesystem>
+
+inline constexpr int TIME_LIMIT = 60;
+// Keep a binary cache of the parsed instances next to the JSON files
+inline constexpr bool USE_INSTANCE_CACHE = true;
+inline constexpr bool EXPORT_SOLUTION = true;
+
+// Consecutive days solved when no instance is given on the command line
+inline const std::vector<std::string> DEFAULT_DAYS = {
+    "agency1_17-01-2023_anonymized",
+    "agency1_18-01-2023_anonymized",
+    "agency1_19-01-2023_anonymized"
+};
+
+
+// Usage : TRP_rolling [instance_name ...] (the instances are solved in the given order)
+int main(int argc, char *argv[]){
+
+    using std::cout, std::endl;
+    using std::vector, std::string;
+    namespace chrono = std::chrono;
+
+    ColumnGenerationParameters parameters = ColumnGenerationParameters({
+        {"time_limit", TIME_LIMIT},
+        {"reduced_cost_threshold", 1e-6},
+        {"verbose", false},
+        {"max_iterations", 1000},
+        {"max_consecutive_non_improvement", 5},
+        {"compute_integer_solution", true},
+        {"compute_intermediate_integer_solutions", false},
+        {"use_maximisation_formulation", false},
+        {"max_resources_dominance", ALL_RESOURCES_DOMINANCE},
+        {"ng", NG_STANDARD},
+        {"dssr", DSSR_STANDARD},
+        {"use_visited", true},
+        {"bidirectional_DP", false},
+        {"pathwyse_time_limit", 0.0},
+        {"switch_to_cyclic_pricing", true},
+        {"solution_pool_size", 10},
+        {"alpha", 0.5},
+        {"use_stabilisation", true},
+        {"pricing_function", PRICING_PATHWYSE_BASIC},
+        {"pricing_verbose", false}
+    });
+
+    vector<string> names(argv + 1, argv + argc);
+    if (names.empty()){
+        names = DEFAULT_DAYS;
+    }
+
+    vector<Instance> days;
+    for (const string& name : names){
+        string filename = "../data/" + name + ".json";
+        cout << "Parsing the instance " << name << " from " << filename << endl;
+        days.push_back(parse_file(filename, name, -1, -1, false, USE_INSTANCE_CACHE));
+        preprocess_interventions(days.back());
+    }
+
+    vector<DayResult> results = rolling_horizon_procedure(days, parameters);
+
+    cout << "-----------------------------------" << endl;
+    int total_iterations = 0;
+    for (int d = 0; d < results.size(); d++){
+        cout << names[d] << " : " << results[d].result.number_of_iterations << " iterations";
+        cout << " - " << results[d].carried_routes << " routes carried over" << endl;
+        total_iterations += results[d].result.number_of_iterations;
+    }
+    cout << "Total number of iterations : " << total_iterations << endl;
+
+    if (EXPORT_SOLUTION){
+        string subfolder = "../results/rolling_horizon/";
+        std::filesystem::create_directories(subfolder);
+        const auto now = chrono::zoned_time(std::chrono::current_zone(), chrono::system_clock::now());
+        string date = std::format("{:%Y-%m-%d-%H-%M-%OS}", now);
+        for (int d = 0; d < results.size(); d++){
+            export_solution(subfolder + names[d] + "_" + date + ".json", days[d], results[d].result, results[d].routes, parameters);
+        }
+    }
+
+    return 0;
+}
@@ -5,6 +5,10 @@
 
 #include "master_problem/master.h"
 #include "master_problem/rmp_solver.h"
+#include "master_problem/node.h"
+#include "master_problem/column_pool.h"
+
+#include "routes/route_optimizer.h"
 
 #include "pricing_problem/full_pricing.h"
 #include "pricing_problem/subproblem.h"
@@ -27,6 +31,11 @@ inline constexpr bool VERBOSE = true;
 
 inline constexpr int DELTA = 10;
 
+// Number of arcs required, then forbidden, to check the pricing problems of a branch and price node
+inline constexpr int N_BRANCHING_CHECKS = 10;
+// Dual of the row x_ijv >= 1 of a required arc in the checks (a bonus in the maximisation formulation)
+inline constexpr double REQUIRED_ARC_DUAL = -500.;
+
 int main(int argc, char *argv[]){
 
     using std::cout, std::endl;
@@ -115,6 +124,102 @@ int main(int argc, char *argv[]){
 
     cout << "Time spent : " << diff << " ms" << endl;
 
+    cout << "-----------------------------------" << endl;
+    cout << "Checking the pricing problems of branch and price nodes" << endl;
+    // Arcs used by the routes of all the vehicles at the current duals
+    vector<int> all_vehicles = {};
+    vector<std::tuple<int, int, int>> used_arcs = {};
+    vector<Route> vehicle_routes = {};
+    for (const Vehicle& vehicle : instance.vehicles){
+        if (vehicle.interventions.empty()) continue;
+        all_vehicles.push_back(vehicle.id);
+        Route route = solve_pricing_problem(instance, vehicle, dual_solution, true, true);
+        vehicle_routes.push_back(route);
+        for (int k = 0; k + 1 < route.id_sequence.size(); k++){
+            used_arcs.push_back({route.id_sequence[k], route.id_sequence[k + 1], vehicle.id});
+        }
+    }
+    std::shuffle(used_arcs.begin(), used_arcs.end(), std::mt19937(0));
+    if (used_arcs.size() > N_BRANCHING_CHECKS){
+        used_arcs.resize(N_BRANCHING_CHECKS);
+    }
+    // Each arc is required in a node, then forbidden in another one
+    // The exact pricing algorithms must only return routes that respect the node, with the reduced cost of the master
+    int n_priced_routes = 0;
+    int n_violations = 0;
+    int n_reduced_cost_errors = 0;
+    for (const auto& arc : used_arcs){
+        for (bool is_required : {true, false}){
+            BPNode branching_node = RootNode({});
+            DualSolution node_duals = dual_solution;
+            if (is_required){
+                branching_node.lower_bound_cuts.insert(arc);
+                node_duals.lower_bound_duals[arc] = REQUIRED_ARC_DUAL;
+            } else {
+                branching_node.upper_bound_cuts.insert(arc);
+            }
+            Instance node_instance = branching_instance(instance, branching_node);
+            vector<Route> priced_routes;
+            auto pricing_groups = create_shared_pricing_groups(node_instance, all_vehicles, true);
+            for (auto& group : pricing_groups){
+                for (int k = 0; k < group.vehicle_indexes.size(); k++){
+                    priced_routes.push_back(solve_shared_pricing_problem(group, k, node_instance, node_duals, true));
+                }
+            }
+            for (int v : all_vehicles){
+                const Vehicle& vehicle = node_instance.vehicles[v];
+                if (vehicle.interventions.empty()) continue;
+                priced_routes.push_back(solve_pricing_problem(node_instance, vehicle, node_duals, true, true));
+                vector<Route> pulse_routes = solve_pricing_problem_pulse(node_instance, vehicle, node_duals, true, DELTA, 1);
+                priced_routes.insert(priced_routes.end(), pulse_routes.begin(), pulse_routes.end());
+            }
+            std::erase_if(priced_routes, [](const Route& route){ return route.vehicle_id < 0; });
+            vector<double> reduced_costs = compute_reduced_costs(build_column_pool(priced_routes, instance, true), node_duals);
+            for (int r = 0; r < priced_routes.size(); r++){
+                n_priced_routes++;
+                if (!respects_branching_cuts(priced_routes[r], branching_node, instance)){
+                    n_violations++;
+                }
+                if (std::abs(reduced_costs[r] - priced_routes[r].reduced_cost) > 1e-6 * std::max(1., std::abs(reduced_costs[r]))){
+                    n_reduced_cost_errors++;
+                }
+            }
+        }
+    }
+    cout << "Priced routes : " << n_priced_routes << " in " << 2 * used_arcs.size() << " nodes";
+    cout << " - Routes violating the node : " << n_violations;
+    cout << " - Wrong reduced costs : " << n_reduced_cost_errors << endl;
+
+    cout << "-----------------------------------" << endl;
+    cout << "Checking the dynamic programming of the route optimizer against the MIP" << endl;
+    // Both are exact on the routes of at most MAX_EXACT_ROUTE_SIZE interventions : they must give the same distance
+    int n_optimized_routes = 0;
+    int n_distance_mismatches = 0;
+    int dp_time = 0;
+    int mip_time = 0;
+    for (const Route& route : vehicle_routes){
+        int n_route_interventions = route.id_sequence.size() - 2;
+        if (n_route_interventions <= 0 || n_route_interventions > MAX_EXACT_ROUTE_SIZE) continue;
+        begin = chrono::steady_clock::now();
+        Route dp_route = optimize_route(route, instance);
+        end = chrono::steady_clock::now();
+        dp_time += chrono::duration_cast<chrono::milliseconds>(end - begin).count();
+        begin = chrono::steady_clock::now();
+        Route mip_route = optimize_route_mip(route, instance);
+        end = chrono::steady_clock::now();
+        mip_time += chrono::duration_cast<chrono::milliseconds>(end - begin).count();
+        n_optimized_routes++;
+        double dp_kilometres = count_route_kilometres(dp_route, instance);
+        double mip_kilometres = count_route_kilometres(mip_route, instance);
+        if (std::abs(dp_kilometres - mip_kilometres) > 1e-6){
+            n_distance_mismatches++;
+            cout << "Vehicle " << route.vehicle_id << " : " << dp_kilometres << " km with the dynamic programming, ";
+            cout << mip_kilometres << " km with the MIP" << endl;
+        }
+    }
+    cout << "Optimized routes : " << n_optimized_routes << " - Distance mismatches : " << n_distance_mismatches << endl;
+    cout << "Time spent : " << dp_time << " ms (dynamic programming) - " << mip_time << " ms (MIP)" << endl;
+
     cout << "-----------------------------------" << endl;
     // cout << "Solving each vehicle with one thread, in parallel" << endl;
 
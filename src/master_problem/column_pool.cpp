@@ -0,0 +1,102 @@
+#include "column_pool.h"
+
+#include "master_problem/subset_row_cuts.h"
+#include "instance/parallel.h"
+
+#include <vector>
+#include <algorithm>
+
+
+// Number of columns priced by each task of compute_reduced_costs
+inline constexpr int COLUMN_BLOCK_SIZE = 1024;
+
+
+ColumnPool build_column_pool(const std::vector<Route>& routes, const Instance& instance, bool use_maximisation_formulation) {
+    ColumnPool pool;
+    pool.use_maximisation_formulation = use_maximisation_formulation;
+    add_columns(pool, routes, instance);
+    return pool;
+}
+
+
+void add_columns(ColumnPool& pool, const std::vector<Route>& routes, const Instance& instance) {
+    for (const Route& route : routes) {
+        // The interventions are read from the sequence, the depot being at both ends
+        for (int k = 1; k + 1 < route.id_sequence.size(); k++) {
+            pool.interventions.push_back(route.id_sequence[k]);
+        }
+        pool.column_start.push_back(pool.interventions.size());
+        pool.vehicles.push_back(route.vehicle_id);
+        bool has_vehicle = route.vehicle_id >= 0 && route.vehicle_id < instance.vehicles.size();
+        pool.depots.push_back(has_vehicle ? instance.vehicles[route.vehicle_id].depot : -1);
+        // Same coefficients as in create_model
+        if (pool.use_maximisation_formulation) {
+            pool.objective.push_back(instance.M * route.total_duration - route.total_cost);
+        } else {
+            pool.objective.push_back(route.total_cost);
+        }
+    }
+}
+
+
+std::vector<double> compute_reduced_costs(const ColumnPool& pool, const DualSolution& duals) {
+    int n_columns = pool.size();
+    std::vector<double> reduced_costs(n_columns);
+    const double* alphas = duals.alphas.data();
+    const int* interventions = pool.interventions.data();
+    int n_blocks = (n_columns + COLUMN_BLOCK_SIZE - 1) / COLUMN_BLOCK_SIZE;
+    parallel_for(n_blocks, [&](int block) {
+        int end = std::min(n_columns, (block + 1) * COLUMN_BLOCK_SIZE);
+        for (int r = block * COLUMN_BLOCK_SIZE; r < end; r++) {
+            // Sparse dot product with the alphas, with independent partial sums
+            int k = pool.column_start[r];
+            int last = pool.column_start[r + 1];
+            double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (; k + 4 <= last; k += 4) {
+                sum0 += alphas[interventions[k]];
+                sum1 += alphas[interventions[k + 1]];
+                sum2 += alphas[interventions[k + 2]];
+                sum3 += alphas[interventions[k + 3]];
+            }
+            for (; k < last; k++) {
+                sum0 += alphas[interventions[k]];
+            }
+            // Routes with an invalid vehicle index only have the objective
+            int v = pool.vehicles[r];
+            double beta = v >= 0 && v < duals.betas.size() ? duals.betas[v] : 0;
+            reduced_costs[r] = pool.objective[r] - (sum0 + sum1) - (sum2 + sum3) - beta;
+            // Subset row cuts : the dual counts once for every two of its interventions in the column (see subset_row_cuts.h)
+            for (const auto& [cut, sigma] : duals.subset_row_duals) {
+                int coefficient = subset_row_coefficient(cut, interventions + pool.column_start[r], interventions + last, subset_row_memory(cut, duals));
+                reduced_costs[r] -= sigma * coefficient;
+            }
+            // Required arcs of the vehicle, looked up in the sequence closed by the depot
+            for (const auto& [ijv, dual] : duals.lower_bound_duals) {
+                const auto& [i, j, cut_vehicle] = ijv;
+                if (cut_vehicle != v) continue;
+                int previous = pool.depots[r];
+                bool uses_arc = false;
+                for (int k = pool.column_start[r]; k <= last && !uses_arc; k++) {
+                    int node = k < last ? interventions[k] : pool.depots[r];
+                    uses_arc = previous == i && node == j;
+                    previous = node;
+                }
+                if (uses_arc) {
+                    reduced_costs[r] -= dual;
+                }
+            }
+        }
+    });
+    return reduced_costs;
+}
+
+
+std::vector<int> improving_columns(const ColumnPool& pool, const std::vector<double>& reduced_costs, double threshold) {
+    std::vector<int> columns;
+    for (int r = 0; r < reduced_costs.size(); r++) {
+        if (pool.use_maximisation_formulation ? reduced_costs[r] > threshold : reduced_costs[r] < - threshold) {
+            columns.push_back(r);
+        }
+    }
+    return columns;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "master_problem/master.h"
+#include "routes/route.h"
+
+#include <vector>
+
+
+/*
+    @struct ColumnPool
+    @brief Intervention incidence of a set of routes, stored by column (CSR), to re-price all of them at once
+
+    The interventions of the column r are interventions[column_start[r] .. column_start[r + 1])
+    With the duals of the master problem, the reduced cost of the column r is
+        objective[r] - sum of the alphas of its interventions - beta of its vehicle
+    in both formulations (objective[r] is its coefficient in the master objective)
+    The route of the column r starts and ends at depots[r] (-1 for the routes without a vehicle)
+*/
+struct ColumnPool {
+    std::vector<int> column_start = {0};
+    std::vector<int> interventions;
+    std::vector<int> vehicles;
+    std::vector<int> depots;
+    std::vector<double> objective;
+    bool use_maximisation_formulation = false;
+
+    int size() const {return vehicles.size();}
+};
+
+
+// Builds the pool of a set of routes
+ColumnPool build_column_pool(const std::vector<Route>& routes, const Instance& instance, bool use_maximisation_formulation);
+
+// Appends routes at the end of a pool, the indices of the columns follow the ones of the routes
+void add_columns(ColumnPool& pool, const std::vector<Route>& routes, const Instance& instance);
+
+
+// Reduced costs of all the columns of the pool for a dual solution, computed in parallel over the columns
+// The subset row cuts and the rows x_ijv >= 1 of the branch and price (lower bound duals) are taken into account
+// The arcs x_ijv <= 0 have no row in the master problem : their columns are fixed to 0
+std::vector<double> compute_reduced_costs(const ColumnPool& pool, const DualSolution& duals);
+
+// Indices of the columns with an improving reduced cost (negative, or positive in the maximisation formulation)
+std::vector<int> improving_columns(const ColumnPool& pool, const std::vector<double>& reduced_costs, double threshold);
@@ -64,6 +64,10 @@ DualSolution operator+(const DualSolution &lhs, const DualSolution &rhs) {
     result.betas = lhs.betas + rhs.betas;
     result.upper_bound_duals = lhs.upper_bound_duals + rhs.upper_bound_duals;
     result.lower_bound_duals = lhs.lower_bound_duals + rhs.lower_bound_duals;
+    result.subset_row_duals = lhs.subset_row_duals + rhs.subset_row_duals;
+    // The memories are not combined : a cut has the same memory in both solutions
+    result.subset_row_memories = lhs.subset_row_memories;
+    result.subset_row_memories.insert(rhs.subset_row_memories.begin(), rhs.subset_row_memories.end());
     return result;
 }
 
@@ -73,9 +77,25 @@ DualSolution operator*(double scalar, const DualSolution &rhs) {
     result.betas = scalar * rhs.betas;
     result.upper_bound_duals = scalar * rhs.upper_bound_duals;
     result.lower_bound_duals = scalar * rhs.lower_bound_duals;
+    result.subset_row_duals = scalar * rhs.subset_row_duals;
+    result.subset_row_memories = rhs.subset_row_memories;
     return result;
 }
 
+std::vector<double> vehicle_alphas(const DualSolution &dual_solution, int vehicle_id) {
+    std::vector<double> alphas = dual_solution.alphas;
+    int n_interventions = alphas.size();
+    for (const auto& [ijv, dual] : dual_solution.lower_bound_duals) {
+        const auto& [i, j, v] = ijv;
+        if (v != vehicle_id) continue;
+        int intervention = i < n_interventions ? i : j;
+        if (intervention < n_interventions) {
+            alphas[intervention] += dual;
+        }
+    }
+    return alphas;
+}
+
 IntegerSolution AllOnesSolution(int n_interventions) {
     std::vector<int> coefficients(n_interventions, 1);
     return IntegerSolution(coefficients, 0.);
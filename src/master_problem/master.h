@@ -10,6 +10,10 @@ struct DualSolution {
     std::vector<double> betas; // Vehicle duals
     std::map<std::tuple<int, int, int>, double> upper_bound_duals;
     std::map<std::tuple<int, int, int>, double> lower_bound_duals;
+    // Duals of the subset row cuts, by triplet of interventions (see subset_row_cuts.h)
+    std::map<std::tuple<int, int, int>, double> subset_row_duals;
+    // Memories of the subset row cuts (a cut without memory, or with an empty one, has the full memory)
+    std::map<std::tuple<int, int, int>, std::vector<int>> subset_row_memories;
 };
 
 // Define convex combination of two dual solutions
@@ -17,6 +21,12 @@ DualSolution operator+(const DualSolution &lhs, const DualSolution &rhs);
 
 DualSolution operator*(double scalar, const DualSolution &rhs);
 
+// Intervention duals seen by the pricing problem of a vehicle
+// The dual of a row x_ijv >= 1 of a branch and price node is added to the alpha of i for the vehicle v (to the alpha of j
+// when i is the depot) : in the pricing instance of the node (see branching_instance), a route of v visits this
+// intervention if and only if it uses the arc (i, j)
+std::vector<double> vehicle_alphas(const DualSolution &dual_solution, int vehicle_id);
+
 // Structure to represent a solution of the master problem
 struct MasterSolution {
     // Is this solution feasible
@@ -39,7 +49,7 @@ struct MasterSolution {
         double objective_value
     ) : 
         coefficients(coefficients),
-        dual_solution({alphas, betas, upper_bound_duals, lower_bound_duals}),
+        dual_solution({alphas, betas, upper_bound_duals, lower_bound_duals, {}, {}}),
         objective_value(objective_value),
         is_feasible(true)
     {}
@@ -52,7 +62,7 @@ struct MasterSolution {
         double objective_value
     ) : 
         coefficients(coefficients),
-        dual_solution({alphas, betas, {}, {}}),
+        dual_solution({alphas, betas, {}, {}, {}, {}}),
         objective_value(objective_value),
         is_feasible(true)
     {}
@@ -3,6 +3,11 @@
 #include "data_analysis/analysis.h"
 
 #include <assert.h>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iostream>
 
 
 GRBModel create_model(
@@ -124,6 +129,79 @@ void add_route(
     }
 }
 
+void add_subset_row_cut(
+    GRBModel& model,
+    const SubsetRowCut& cut,
+    const std::vector<int>& memory,
+    const std::vector<Route>& routes,
+    const std::vector<GRBVar>& route_vars,
+    std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs
+) {
+    GRBLinExpr expr = 0;
+    for (int r = 0; r < routes.size(); r++){
+        int coefficient = subset_row_coefficient(cut, routes[r], memory);
+        if (coefficient > 0){
+            expr += coefficient * route_vars[r];
+        }
+    }
+    subset_row_ctrs[cut] = model.addConstr(expr <= 1);
+}
+
+
+void add_route_to_subset_row_cuts(
+    GRBModel& model,
+    const Route& route,
+    const GRBVar& route_var,
+    const std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs,
+    const std::map<SubsetRowCut, std::vector<int>>& subset_row_memories
+) {
+    for (const auto& [cut, constraint] : subset_row_ctrs){
+        int coefficient = subset_row_coefficient(cut, route, subset_row_memories.at(cut));
+        if (coefficient > 0){
+            model.chgCoeff(constraint, route_var, coefficient);
+        }
+    }
+}
+
+
+void add_branching_rows(
+    GRBModel& model,
+    const BPNode& node,
+    const std::vector<Route>& routes,
+    const std::vector<GRBVar>& route_vars,
+    std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs,
+    std::vector<GRBVar>& artificial_vars,
+    double penalty,
+    bool use_maximisation_formulation
+) {
+    for (const auto& [i, j, v] : node.lower_bound_cuts){
+        artificial_vars.push_back(model.addVar(0.0, 1.0, use_maximisation_formulation ? - penalty : penalty, GRB_CONTINUOUS));
+        GRBLinExpr expr = artificial_vars.back();
+        for (int r = 0; r < routes.size(); r++){
+            if (routes[r].vehicle_id == v && routes[r].route_edges[i][j] == 1){
+                expr += route_vars[r];
+            }
+        }
+        branching_ctrs[{i, j, v}] = model.addConstr(expr >= 1);
+    }
+}
+
+
+void add_route_to_branching_rows(
+    GRBModel& model,
+    const Route& route,
+    const GRBVar& route_var,
+    const std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs
+) {
+    for (const auto& [ijv, constraint] : branching_ctrs){
+        const auto& [i, j, v] = ijv;
+        if (route.vehicle_id == v && route.route_edges[i][j] == 1){
+            model.chgCoeff(constraint, route_var, 1);
+        }
+    }
+}
+
+
 int solve_model(GRBModel& model, double time_limit) {
     if (time_limit > 0){
         model.set(GRB_DoubleParam_TimeLimit, time_limit);
@@ -138,7 +216,10 @@ MasterSolution extract_solution(
     const GRBModel& model,
     const std::vector<GRBVar>& route_vars,
     const std::vector<GRBConstr>& intervention_ctrs,
-    const std::vector<GRBConstr>& vehicle_ctrs
+    const std::vector<GRBConstr>& vehicle_ctrs,
+    const std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs,
+    const std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs,
+    const std::map<SubsetRowCut, std::vector<int>>& subset_row_memories
 ) {
     using std::vector;
     // Get the objective value
@@ -160,7 +241,15 @@ MasterSolution extract_solution(
         betas.push_back(constraint.get(GRB_DoubleAttr_Pi));
     }
 
-    return MasterSolution{coefficients, alphas, betas, objective_value};
+    MasterSolution solution = MasterSolution{coefficients, alphas, betas, objective_value};
+    for (const auto& [cut, constraint] : subset_row_ctrs){
+        solution.dual_solution.subset_row_duals[cut] = constraint.get(GRB_DoubleAttr_Pi);
+    }
+    solution.dual_solution.subset_row_memories = subset_row_memories;
+    for (const auto& [ijv, constraint] : branching_ctrs){
+        solution.dual_solution.lower_bound_duals[ijv] = constraint.get(GRB_DoubleAttr_Pi);
+    }
+    return solution;
 
 }
 
@@ -226,6 +315,85 @@ IntegerSolution solve_intermediary_integer_model(
 }
 
 
+// Copy of a model with its own environment, for the background integer solves
+// The model is declared after the environment, so that it is destroyed first
+struct ModelSnapshot {
+    std::unique_ptr<GRBEnv> env;
+    std::unique_ptr<GRBModel> model;
+    // Set when the solve is stopped before it starts
+    std::atomic<bool> is_stopped = false;
+};
+
+
+BackgroundIntegerSolve launch_intermediary_integer_model(
+    GRBModel& model,
+    const std::vector<GRBVar>& route_vars,
+    const std::vector<GRBVar>& postpone_vars,
+    double time_limit
+) {
+    using std::vector;
+    // The copy is made in the calling thread, after applying the pending modifications of the model
+    model.update();
+    vector<int> route_indexes;
+    for (const GRBVar& var : route_vars){
+        route_indexes.push_back(var.index());
+    }
+    vector<int> postpone_indexes;
+    for (const GRBVar& var : postpone_vars){
+        postpone_indexes.push_back(var.index());
+    }
+    // Gurobi environments can not be shared between threads, the snapshot gets its own
+    // It only uses half of the threads, the other half being left to the column generation
+    auto snapshot = std::make_shared<ModelSnapshot>();
+    snapshot->env = std::make_unique<GRBEnv>(true);
+    snapshot->env->set(GRB_IntParam_OutputFlag, 0);
+    snapshot->env->set(GRB_IntParam_Threads, std::max(1, (int) std::thread::hardware_concurrency() / 2));
+    snapshot->env->start();
+    snapshot->model = std::make_unique<GRBModel>(model, *snapshot->env);
+
+    BackgroundIntegerSolve integer_solve;
+    integer_solve.snapshot = snapshot;
+    integer_solve.solution = std::async(std::launch::async, [snapshot, route_indexes, postpone_indexes, time_limit]() {
+        // An exception can not leave the thread : a Gurobi error gives an infeasible solution
+        try {
+            vector<GRBVar> snapshot_route_vars;
+            for (int index : route_indexes){
+                snapshot_route_vars.push_back(snapshot->model->getVar(index));
+            }
+            vector<GRBVar> snapshot_postpone_vars;
+            for (int index : postpone_indexes){
+                snapshot_postpone_vars.push_back(snapshot->model->getVar(index));
+            }
+            set_integer_variables(*snapshot->model, snapshot_route_vars, snapshot_postpone_vars);
+            if (snapshot->is_stopped){
+                return IntegerSolution{};
+            }
+            solve_model(*snapshot->model, time_limit);
+            return extract_integer_solution(*snapshot->model, snapshot_route_vars);
+        } catch(GRBException e) {
+            std::cout << "Background integer solve - Error code = " << e.getErrorCode() << std::endl;
+            std::cout << e.getMessage() << std::endl;
+        }
+        return IntegerSolution{};
+    });
+    return integer_solve;
+}
+
+
+void stop_intermediary_integer_model(BackgroundIntegerSolve& integer_solve) {
+    if (!integer_solve.valid()){
+        return;
+    }
+    integer_solve.snapshot->is_stopped = true;
+    // The termination request is repeated until the thread ends, in case it was sent before the solve started
+    while (integer_solve.solution.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready){
+        integer_solve.snapshot->model->terminate();
+    }
+    integer_solve.snapshot->model->terminate();
+    integer_solve.solution.get();
+}
+
+
 std::vector<double> convert_min_max_objective(const std::vector<double>& objectives, const Instance& instance){
     // Compute the constant part of the objective
     double constant_part = 0;
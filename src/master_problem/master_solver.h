@@ -4,10 +4,14 @@
 #include "master_problem/master.h"
 #include "routes/route.h"
 #include "master_problem/node.h"
+#include "master_problem/subset_row_cuts.h"
 
 #include "gurobi_c++.h"
 
 #include <vector>
+#include <map>
+#include <future>
+#include <memory>
 
 
 // - Creates a Gurobi model from an instance and a set of routes
@@ -44,6 +48,50 @@ void add_route(
 );
 
 
+// Adds a subset row cut with the given memory to the model, with the coefficients of all the existing routes
+void add_subset_row_cut(
+    GRBModel& model,
+    const SubsetRowCut& cut,
+    const std::vector<int>& memory,
+    const std::vector<Route>& routes,
+    const std::vector<GRBVar>& route_vars,
+    std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs
+);
+
+// Sets the coefficients of a route (already added with add_route) in the subset row cuts, with their memories
+void add_route_to_subset_row_cuts(
+    GRBModel& model,
+    const Route& route,
+    const GRBVar& route_var,
+    const std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs,
+    const std::map<SubsetRowCut, std::vector<int>>& subset_row_memories
+);
+
+
+// Adds the rows x_ijv >= 1 of a branch and price node : the routes of v using the arc (i, j) are selected at least once
+// Each row gets an artificial variable, that keeps the model feasible until the pricing finds such routes
+// Its objective coefficient is the penalty (in the direction that degrades the objective) : an artificial variable
+// still positive when the column generation ends means that the node is infeasible
+void add_branching_rows(
+    GRBModel& model,
+    const BPNode& node,
+    const std::vector<Route>& routes,
+    const std::vector<GRBVar>& route_vars,
+    std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs,
+    std::vector<GRBVar>& artificial_vars,
+    double penalty,
+    bool use_maximisation_formulation = false
+);
+
+// Sets the coefficients of a route (already added with add_route) in the rows x_ijv >= 1
+void add_route_to_branching_rows(
+    GRBModel& model,
+    const Route& route,
+    const GRBVar& route_var,
+    const std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs
+);
+
+
 // Solve the current version of the model
 // Returns a status code
 int solve_model(GRBModel& model, double time_limit = -1.);
@@ -53,7 +101,10 @@ MasterSolution extract_solution(
     const GRBModel& model,
     const std::vector<GRBVar>& route_vars,
     const std::vector<GRBConstr>& intervention_ctrs,
-    const std::vector<GRBConstr>& vehicle_ctrs
+    const std::vector<GRBConstr>& vehicle_ctrs,
+    const std::map<SubsetRowCut, GRBConstr>& subset_row_ctrs = {},
+    const std::map<std::tuple<int, int, int>, GRBConstr>& branching_ctrs = {},
+    const std::map<SubsetRowCut, std::vector<int>>& subset_row_memories = {}
 );
 
 
@@ -87,6 +138,33 @@ IntegerSolution solve_intermediary_integer_model(
     double time_limit = -1.
 );
 
+// Copy of a model solved in a background thread (see launch_intermediary_integer_model)
+struct ModelSnapshot;
+
+// Integer solve of a snapshot of the master problem, running in a background thread
+struct BackgroundIntegerSolve {
+    std::future<IntegerSolution> solution;
+    // Snapshot being solved, shared with the thread so that the solve can be stopped
+    std::shared_ptr<ModelSnapshot> snapshot;
+
+    bool valid() const {return solution.valid();}
+};
+
+// Starts the integer solve of a snapshot of the model in a background thread, and returns the future integer solution
+// The snapshot is a copy of the model with its own Gurobi environment : the model itself is not modified,
+// and can keep being solved and extended while the integer model is solved
+// The solution is indexed by the route variables existing at the time of the call
+// A Gurobi error in the thread gives an infeasible solution (no exception is rethrown by the future)
+BackgroundIntegerSolve launch_intermediary_integer_model(
+    GRBModel& model,
+    const std::vector<GRBVar>& route_vars,
+    const std::vector<GRBVar>& postpone_vars,
+    double time_limit = -1.
+);
+
+// Stops a background integer solve and waits for its thread, its solution is discarded
+void stop_intermediary_integer_model(BackgroundIntegerSolve& integer_solve);
+
 // Convert a list of objective values in the maximisation formulation to the minimisation formulation or vice versa
 std::vector<double> convert_min_max_objective(const std::vector<double>& objectives, const Instance& instance);
 
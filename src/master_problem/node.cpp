@@ -1,6 +1,7 @@
 #include "node.h"
 
 #include <vector>
+#include <tuple>
 
 
 BPNode RootNode(const std::vector<Route>& initial_routes){
@@ -11,4 +12,71 @@ BPNode RootNode(const std::vector<Route>& initial_routes){
         root.active_routes.insert(i);
     }
     return root;
-}
\ No newline at end of file
+}
+
+
+bool respects_branching_cuts(const Route& route, const BPNode& node, const Instance& instance){
+    int n_interventions = instance.number_interventions;
+    bool is_empty = route.id_sequence.size() <= 2;
+    for (const auto& [i, j, v] : node.upper_bound_cuts){
+        if (route.vehicle_id == v && route.route_edges[i][j] == 1){
+            return false;
+        }
+    }
+    for (const auto& [i, j, v] : node.lower_bound_cuts){
+        // Whether the route goes through i or j (the depot only matters for the non empty routes of v)
+        bool visits_i = i < n_interventions ? route.is_in_route[i] == 1 : route.vehicle_id == v && !is_empty;
+        bool visits_j = j < n_interventions ? route.is_in_route[j] == 1 : route.vehicle_id == v && !is_empty;
+        if (!visits_i && !visits_j){
+            continue;
+        }
+        if (route.vehicle_id != v || route.route_edges[i][j] == 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+Instance branching_instance(const Instance& instance, const BPNode& node){
+    using std::vector;
+    Instance node_instance = instance;
+    int n_interventions = instance.number_interventions;
+    // The interventions of the required arcs can only be done by their vehicle
+    vector<int> is_reserved(instance.nodes.size(), 0);
+    vector<int> reserved_vehicle(instance.nodes.size(), -1);
+    for (const auto& [i, j, v] : node.lower_bound_cuts){
+        for (int node_id : {i, j}){
+            if (node_id < n_interventions){
+                is_reserved[node_id] = 1;
+                reserved_vehicle[node_id] = v;
+            }
+        }
+    }
+    for (Vehicle& vehicle : node_instance.vehicles){
+        vector<int> removed(instance.nodes.size(), 0);
+        for (int intervention : vehicle.interventions){
+            removed[intervention] = is_reserved[intervention] && reserved_vehicle[intervention] != vehicle.id;
+        }
+        vehicle = vehicle_mask(vehicle, removed, KEEP_NON_COVERED);
+    }
+
+    for (const auto& [i, j, v] : node.upper_bound_cuts){
+        node_instance.vehicles[v].forbidden_arcs.insert({i, j});
+    }
+    for (const auto& [i, j, v] : node.lower_bound_cuts){
+        Vehicle& vehicle = node_instance.vehicles[v];
+        // Nodes of the vehicle : its interventions and its depot
+        vector<int> vehicle_nodes = vehicle.interventions;
+        vehicle_nodes.push_back(vehicle.depot);
+        for (int k : vehicle_nodes){
+            if (k != j){
+                vehicle.forbidden_arcs.insert({i, k});
+            }
+            if (k != i){
+                vehicle.forbidden_arcs.insert({k, j});
+            }
+        }
+    }
+    return node_instance;
+}
@@ -23,4 +23,16 @@ struct BPNode {
 };
 
 // Create the root node of the branch and price tree from a set of initial routes
-BPNode RootNode(const std::vector<Route>& initial_routes);
\ No newline at end of file
+BPNode RootNode(const std::vector<Route>& initial_routes);
+
+
+// Whether a route respects the branching decisions of a node
+// - for x_ijv <= 0, the vehicle v does not use the arc (i, j)
+// - for x_ijv >= 1, the interventions i and j are only visited by the vehicle v, and always consecutively
+//   (a route of v that leaves or enters the depot through another arc does not respect an arc at the depot)
+bool respects_branching_cuts(const Route& route, const BPNode& node, const Instance& instance);
+
+// Copy of the instance in which the branching decisions of a node are imposed on the vehicles, for the pricing problems
+// The arcs forbidden by the cuts are added to the forbidden arcs of the vehicles, and for a required arc (i, j) of a
+// vehicle v, the other arcs leaving i and entering j are forbidden for v, while i and j are removed from the other vehicles
+Instance branching_instance(const Instance& instance, const BPNode& node);
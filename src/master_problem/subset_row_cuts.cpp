@@ -0,0 +1,182 @@
+#include "subset_row_cuts.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <array>
+
+
+// Value under which a route is not considered in the separation
+inline constexpr double SUBSET_ROW_EPSILON = 1e-6;
+
+
+int subset_row_coefficient(const SubsetRowCut& cut, const Route& route, const std::vector<int>& memory) {
+    if (memory.empty()) {
+        const auto& [i, j, k] = cut;
+        return (route.is_in_route[i] + route.is_in_route[j] + route.is_in_route[k]) / 2;
+    }
+    // The depot is at both ends of the sequence
+    if (route.id_sequence.size() <= 2) {
+        return 0;
+    }
+    return subset_row_coefficient(cut, route.id_sequence.data() + 1, route.id_sequence.data() + route.id_sequence.size() - 1, memory);
+}
+
+
+int subset_row_coefficient(const SubsetRowCut& cut, const int* first, const int* last, const std::vector<int>& memory) {
+    const auto& [i, j, k] = cut;
+    // Number of interventions of the cut visited since the last pair (or since the last intervention out of the memory)
+    int count = 0;
+    int coefficient = 0;
+    for (const int* node = first; node != last; node++) {
+        if (*node == i || *node == j || *node == k) {
+            count++;
+            if (count == 2) {
+                coefficient++;
+                count = 0;
+            }
+        } else if (!memory.empty() && !std::binary_search(memory.begin(), memory.end(), *node)) {
+            count = 0;
+        }
+    }
+    return coefficient;
+}
+
+
+// Memory of a cut in a dual solution (empty for the full memory)
+const std::vector<int>& subset_row_memory(const SubsetRowCut& cut, const DualSolution& dual_solution) {
+    static const std::vector<int> full_memory;
+    auto it = dual_solution.subset_row_memories.find(cut);
+    return it == dual_solution.subset_row_memories.end() ? full_memory : it->second;
+}
+
+
+double subset_row_penalty(const std::vector<int>& sequence, const DualSolution& dual_solution) {
+    double penalty = 0;
+    // The depot is at both ends of the sequence
+    if (sequence.size() <= 2) {
+        return penalty;
+    }
+    for (const auto& [cut, sigma] : dual_solution.subset_row_duals) {
+        int coefficient = subset_row_coefficient(cut, sequence.data() + 1, sequence.data() + sequence.size() - 1, subset_row_memory(cut, dual_solution));
+        penalty += sigma * coefficient;
+    }
+    return penalty;
+}
+
+
+double subset_row_penalty(const Route& route, const DualSolution& dual_solution) {
+    double penalty = 0;
+    for (const auto& [cut, sigma] : dual_solution.subset_row_duals) {
+        penalty += sigma * subset_row_coefficient(cut, route, subset_row_memory(cut, dual_solution));
+    }
+    return penalty;
+}
+
+
+std::vector<SubsetRowCut> separate_subset_row_cuts(
+    const MasterSolution& solution,
+    const std::vector<Route>& routes,
+    const Instance& instance,
+    int max_cuts,
+    std::map<SubsetRowCut, std::vector<int>>& memories,
+    bool use_limited_memory
+) {
+    using std::vector;
+
+    int n_interventions = instance.number_interventions;
+    // Fractional routes covering each intervention
+    vector<int> fractional_routes;
+    vector<vector<int>> covering_routes(n_interventions);
+    for (int r = 0; r < solution.coefficients.size(); r++) {
+        double value = solution.coefficients[r];
+        if (value < SUBSET_ROW_EPSILON || value > 1 - SUBSET_ROW_EPSILON) continue;
+        fractional_routes.push_back(r);
+        for (int k = 1; k + 1 < routes[r].id_sequence.size(); k++) {
+            covering_routes[routes[r].id_sequence[k]].push_back(r);
+        }
+    }
+
+    // Value of the fractional routes covering each pair of interventions
+    vector<vector<double>> pair_values(n_interventions, vector<double>(n_interventions, 0));
+    for (int r : fractional_routes) {
+        const vector<int>& sequence = routes[r].id_sequence;
+        for (int a = 1; a + 1 < sequence.size(); a++) {
+            for (int b = a + 1; b + 1 < sequence.size(); b++) {
+                pair_values[sequence[a]][sequence[b]] += solution.coefficients[r];
+                pair_values[sequence[b]][sequence[a]] += solution.coefficients[r];
+            }
+        }
+    }
+
+    // A cut is violated only if two of its pairs of interventions are covered by fractional routes,
+    // since the routes covering a single pair sum to at most 1. These two pairs share an intervention,
+    // so the triplets are built around each intervention from its neighbours in the positive pairs
+    std::set<SubsetRowCut> triplets;
+    for (int center = 0; center < n_interventions; center++) {
+        vector<int> neighbours;
+        for (int other = 0; other < n_interventions; other++) {
+            if (other != center && pair_values[center][other] > SUBSET_ROW_EPSILON) neighbours.push_back(other);
+        }
+        for (int a = 0; a < neighbours.size(); a++) {
+            for (int b = a + 1; b < neighbours.size(); b++) {
+                std::array<int, 3> sorted = {center, neighbours[a], neighbours[b]};
+                std::sort(sorted.begin(), sorted.end());
+                triplets.insert({sorted[0], sorted[1], sorted[2]});
+            }
+        }
+    }
+
+    // The routes covering the three interventions are counted in the three pairs, so this is an upper bound
+    vector<std::pair<double, SubsetRowCut>> violated_cuts;
+    for (const SubsetRowCut& cut : triplets) {
+        if (memories.contains(cut)) continue;
+        auto [i, j, k] = cut;
+        if (pair_values[i][j] + pair_values[i][k] + pair_values[j][k] <= 1 + SUBSET_ROW_MIN_VIOLATION) continue;
+        // Exact value of the left hand side, over the routes covering at least two of the interventions
+        double lhs = 0;
+        for (int node : {i, j}) {
+            for (int r : covering_routes[node]) {
+                // Each route is counted once, from the first of its interventions in the cut
+                if (node == j && routes[r].is_in_route[i]) continue;
+                lhs += solution.coefficients[r] * subset_row_coefficient(cut, routes[r]);
+            }
+        }
+        if (lhs > 1 + SUBSET_ROW_MIN_VIOLATION) {
+            violated_cuts.push_back({lhs - 1, cut});
+        }
+    }
+
+    std::sort(violated_cuts.begin(), violated_cuts.end(), [](const auto& a, const auto& b) {return a.first > b.first;});
+    vector<SubsetRowCut> cuts;
+    for (int c = 0; c < violated_cuts.size() && c < max_cuts; c++) {
+        cuts.push_back(violated_cuts[c].second);
+    }
+
+    // Memories of the new cuts
+    for (const SubsetRowCut& cut : cuts) {
+        vector<int>& memory = memories[cut];
+        if (!use_limited_memory) continue;
+        auto [i, j, k] = cut;
+        std::set<int> in_memory = {i, j, k};
+        for (int node : {i, j}) {
+            for (int r : covering_routes[node]) {
+                if (node == j && routes[r].is_in_route[i]) continue;
+                if (subset_row_coefficient(cut, routes[r]) == 0) continue;
+                // Interventions between the first two interventions of the cut in the route
+                const vector<int>& sequence = routes[r].id_sequence;
+                int n_visited = 0;
+                for (int a = 1; a + 1 < sequence.size() && n_visited < 2; a++) {
+                    bool is_member = sequence[a] == i || sequence[a] == j || sequence[a] == k;
+                    n_visited += is_member;
+                    if (n_visited == 1 && !is_member) {
+                        in_memory.insert(sequence[a]);
+                    }
+                }
+            }
+        }
+        memory = vector<int>(in_memory.begin(), in_memory.end());
+    }
+    return cuts;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "master_problem/master.h"
+#include "routes/route.h"
+
+#include <vector>
+#include <map>
+#include <tuple>
+
+
+// Minimum violation of a subset row cut for it to be added to the master problem
+inline constexpr double SUBSET_ROW_MIN_VIOLATION = 1e-3;
+
+
+/*
+    Subset row cuts over three interventions (3-SRC), for the maximisation formulation of the master problem
+    A cut (i, j, k) (with i < j < k) is
+        sum over the routes r of floor(number of interventions of {i, j, k} in r / 2) * x_r <= 1
+    that is, at most one route covers two of the three interventions. It is valid for the integer solutions, where
+    each intervention is covered at most once, and is a rank-1 Chvatal-Gomory cut of the intervention constraints
+    Its dual sigma (>= 0) adds - sigma * coefficient to the reduced cost of the routes
+
+    A cut can have a limited memory, a set of interventions containing i, j and k : a route forgets the interventions
+    of the cut it visited when it visits an intervention out of the memory, and its coefficient only counts the pairs
+    visited without forgetting. This weakens the cut for the routes that are not in the memory, but the pricing
+    problems only track it on the memory. An empty memory is the full memory (the coefficient above)
+*/
+using SubsetRowCut = std::tuple<int, int, int>;
+
+
+// Coefficient of a route in a subset row cut (0 or 1), with the given memory (in increasing order, empty for the full one)
+int subset_row_coefficient(const SubsetRowCut& cut, const Route& route, const std::vector<int>& memory = {});
+
+// Same, for the interventions [first, last) of a route, in the order of the route
+int subset_row_coefficient(const SubsetRowCut& cut, const int* first, const int* last, const std::vector<int>& memory);
+
+// Memory of a cut in a dual solution (empty for the full memory)
+const std::vector<int>& subset_row_memory(const SubsetRowCut& cut, const DualSolution& dual_solution);
+
+// Sum of sigma * coefficient over the subset row cuts of a dual solution (with their memories), for a sequence of nodes
+// This is to be removed from the reduced cost of the route in both formulations
+double subset_row_penalty(const std::vector<int>& sequence, const DualSolution& dual_solution);
+
+// Same, for a route
+double subset_row_penalty(const Route& route, const DualSolution& dual_solution);
+
+
+// Separation of the subset row cuts violated by a relaxed solution of the master problem
+// The triplets are built from the pairs of interventions covered together by fractional routes:
+// a violated cut has two such pairs, that share one of its interventions
+// memories holds the memory of every cut of the model : these cuts are not separated again
+// Returns at most max_cuts cuts, by decreasing violation, and adds their memories to memories
+// With use_limited_memory, the memory of a cut is the smallest one keeping the coefficients of the fractional routes :
+// the interventions visited by each route between the first two interventions of the cut it covers
+std::vector<SubsetRowCut> separate_subset_row_cuts(
+    const MasterSolution& solution,
+    const std::vector<Route>& routes,
+    const Instance& instance,
+    int max_cuts,
+    std::map<SubsetRowCut, std::vector<int>>& memories,
+    bool use_limited_memory = false
+);
@@ -5,8 +5,10 @@
 #include "routes/route_optimizer.h"
 #include "clustering/clustering.h"
 #include "tabu.h"
+#include "instance/parallel.h"
 
 #include <vector>
+#include <map>
 #include <execution>
 #include <memory>
 #include <random>
@@ -21,15 +23,50 @@ std::vector<Route> full_pricing_problems_basic(
     const std::vector<int> &vehicle_order,
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
-    int n_ressources_dominance
+    int n_ressources_dominance,
+    const SolverConfig & config
+    ){
+    std::vector<SharedPricingProblems> pricing_groups;
+    return full_pricing_problems_basic(solution, instance, vehicle_order, use_maximisation_formulation,
+        using_cyclic_pricing, n_ressources_dominance, config, pricing_groups);
+}
+
+
+std::vector<Route> full_pricing_problems_basic(
+    const DualSolution & solution,
+    const Instance & instance,
+    const std::vector<int> &vehicle_order,
+    bool use_maximisation_formulation,
+    bool using_cyclic_pricing,
+    int n_ressources_dominance,
+    const SolverConfig & config,
+    std::vector<SharedPricingProblems> & pricing_groups
     ){
     using std::vector;
     using std::packaged_task;
     using std::future;
-    
-    auto single_pricer = [&](int v){
-            return solve_pricing_problem(instance, instance.vehicles.at(v), solution,
-                use_maximisation_formulation, using_cyclic_pricing, n_ressources_dominance);
+
+    // Vehicles with the same depot share the graph and the arc data of their pricing problems
+    if (pricing_groups.empty()){
+        pricing_groups = create_shared_pricing_groups(instance, vehicle_order, using_cyclic_pricing);
+    }
+    // Position of each vehicle of vehicle_order in the groups (group, index in group)
+    vector<std::pair<int, int>> group_positions(vehicle_order.size());
+    std::map<int, int> order_position;
+    for (int i = 0; i < vehicle_order.size(); i++){
+        order_position[vehicle_order[i]] = i;
+    }
+    for (int g = 0; g < pricing_groups.size(); g++){
+        const vector<int>& vehicle_indexes = pricing_groups[g].vehicle_indexes;
+        for (int k = 0; k < vehicle_indexes.size(); k++){
+            group_positions[order_position.at(vehicle_indexes[k])] = {g, k};
+        }
+    }
+
+    auto single_pricer = [&](int i){
+            auto [g, k] = group_positions[i];
+            return solve_shared_pricing_problem(pricing_groups[g], k, instance, solution,
+                use_maximisation_formulation, n_ressources_dominance, config);
         };
 
     vector<packaged_task<Route(int)>> tasks;
@@ -46,7 +83,7 @@ std::vector<Route> full_pricing_problems_basic(
     // Sequential execution
     vector<Route> new_routes_parallel(vehicle_order.size());
     for (int i = 0; i < tasks.size(); i++){
-        threads[i] = std::thread(std::move(tasks[i]), vehicle_order[i]);
+        threads[i] = std::thread(std::move(tasks[i]), i);
     }
 
     for (int i = 0; i < tasks.size(); i++){
@@ -65,6 +102,7 @@ std::vector<Route> full_pricing_problems_diversification(
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
     int n_ressources_dominance,
+    const SolverConfig & config,
     int seed
 ) {
     using std::vector;
@@ -97,7 +135,7 @@ std::vector<Route> full_pricing_problems_diversification(
             }
             // Solve the pricing problem for the vehicle
             Route new_route = solve_pricing_problem(instance, vehicle, solution,
-                use_maximisation_formulation, using_cyclic_pricing, n_ressources_dominance);
+                use_maximisation_formulation, using_cyclic_pricing, n_ressources_dominance, config);
             // If the reduced cost is greater than the threshold, we add the route
             if (new_route.id_sequence.size() > 2){
                 private_new_routes.push_back(new_route);
@@ -150,6 +188,7 @@ std::vector<Route> full_pricing_problems_clustering(
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
     int n_ressources_dominance,
+    const SolverConfig & config,
     int seed
     ){
     using std::vector;
@@ -180,7 +219,8 @@ std::vector<Route> full_pricing_problems_clustering(
             vehicle_order, 
             use_maximisation_formulation,
             using_cyclic_pricing, 
-            n_ressources_dominance
+            n_ressources_dominance,
+            config
             );
         new_routes.insert(new_routes.end(), new_routes_cluster.begin(), new_routes_cluster.end());
     }
@@ -194,32 +234,23 @@ std::vector<Route> full_pricing_problems_tabu_search(
     const Instance & instance,
     const std::vector<int> &vehicle_order,
     bool use_maximisation_formulation,
-    bool using_cyclic_pricing,
-    int n_ressources_dominance,
     int max_iterations,
-    int max_modifications,
-    int seed
+    int tabu_tenure
     ){
-    using std::vector, std::unique_ptr;
-
-    vector<Route> new_routes = {};
+    using std::vector;
 
-    for (int v : vehicle_order){
-        // Compute a first route using the pricing problem
-        const Vehicle& vehicle = instance.vehicles.at(v);
-        Route new_route = solve_pricing_problem(instance, vehicle, solution,
-            use_maximisation_formulation, using_cyclic_pricing, n_ressources_dominance);
-        // If this route is empty, we skip it
-        if (new_route.id_sequence.size() <= 2){
-            continue;
-        }        
-        // Then, we perform the tabu search
-        vector<Route> tabu_list = tabu_search(new_route, max_iterations, max_modifications, solution, vehicle, instance);
+    // The vehicles are independent : run their searches in parallel, each starting from the empty route
+    vector<vector<Route>> routes_per_vehicle(vehicle_order.size());
+    parallel_for(vehicle_order.size(), [&](int k){
+        const Vehicle& vehicle = instance.vehicles.at(vehicle_order[k]);
+        routes_per_vehicle[k] = tabu_search(EmptyRoute(0), max_iterations, tabu_tenure, solution, vehicle, instance,
+            use_maximisation_formulation);
+    });
 
-        // We add the new routes to the list of new routes
-        new_routes.insert(new_routes.end(), tabu_list.begin(), tabu_list.end());
+    vector<Route> new_routes = {};
+    for (const vector<Route>& routes : routes_per_vehicle){
+        new_routes.insert(new_routes.end(), routes.begin(), routes.end());
     }
-
     return new_routes;
 }
 
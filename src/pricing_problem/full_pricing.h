@@ -4,6 +4,9 @@
 #include "instance/instance.h"
 #include "routes/route.h"
 #include "master_problem/master.h"
+#include "pricing_problem/subproblem.h"
+
+#include "../../pathwyse/core/utils/param.h"
 
 #include <vector>
 #include <random>
@@ -19,7 +22,20 @@ std::vector<Route> full_pricing_problems_basic(
     const std::vector<int> & vehicle_order,
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
-    int n_ressources_dominance
+    int n_ressources_dominance,
+    const SolverConfig & config
+);
+// Same as above, reusing the pricing problems of pricing_groups between calls (built on the first call, if empty)
+// The graph, the arc data and the resource bounds of the problems are kept, only the node costs are updated
+std::vector<Route> full_pricing_problems_basic(
+    const DualSolution & solution,
+    const Instance & instance,
+    const std::vector<int> & vehicle_order,
+    bool use_maximisation_formulation,
+    bool using_cyclic_pricing,
+    int n_ressources_dominance,
+    const SolverConfig & config,
+    std::vector<SharedPricingProblems> & pricing_groups
 );
 
 
@@ -35,6 +51,7 @@ std::vector<Route> full_pricing_problems_diversification(
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
     int n_ressources_dominance,
+    const SolverConfig & config,
     int seed = RANDOM_SEED
 );
 
@@ -46,21 +63,21 @@ std::vector<Route> full_pricing_problems_clustering(
     bool use_maximisation_formulation,
     bool using_cyclic_pricing,
     int n_ressources_dominance,
+    const SolverConfig & config,
     int seed = RANDOM_SEED
     );
 
 
+// Heuristic pricing : tabu search on the sequences of each vehicle (see tabu.h), the vehicles being solved in parallel
+// Can also be used as the first of the pricing tiers (see ColumnGenerationParameters::pricing_tiers)
 inline constexpr std::string PRICING_TABU_SEARCH = "tabu_search";
 std::vector<Route> full_pricing_problems_tabu_search(
     const DualSolution & solution,
     const Instance & instance,
     const std::vector<int> &vehicle_order,
     bool use_maximisation_formulation,
-    bool using_cyclic_pricing,
-    int n_ressources_dominance,
     int max_iterations,
-    int max_modifications,
-    int seed = RANDOM_SEED
+    int tabu_tenure
     );
 
 
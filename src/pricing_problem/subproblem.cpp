@@ -2,6 +2,7 @@
 
 #include "instance/constants.h"
 #include "pricing_problem/time_window_lunch.h"
+#include "master_problem/subset_row_cuts.h"
 
 #include "../../pathwyse/core/solver.h"
 
@@ -23,6 +24,95 @@ using std::vector, std::list, std::string;
 using std::unique_ptr;
 
 
+// Adds the feasible arcs between the interventions of a vehicle to a pricing problem
+// Intervention k of the vehicle is node k of the problem, the depot is split into origin and destination
+// Uses the feasible successors index of the instance when it is available (O(arcs)), and is_edge_feasible otherwise
+void set_pricing_arcs(Problem& problem, const Instance& instance, const Vehicle& vehicle, int origin, int destination) {
+    int n_interventions_v = vehicle.interventions.size();
+    // The arcs forbidden by the branching are never added
+    auto set_arc = [&](int i, int j, int true_i, int true_j) {
+        if (vehicle.forbidden_arcs.empty() || !vehicle.forbidden_arcs.contains({true_i, true_j})) {
+            problem.setNetworkArc(i, j);
+        }
+    };
+    if (instance.successors_start.empty()) {
+        for (int i = 0; i < n_interventions_v ; i++) {
+            if (is_edge_feasible(vehicle.depot, vehicle.interventions[i], instance)) {
+                set_arc(origin, i, vehicle.depot, vehicle.interventions[i]);
+            }
+            for (int j = 0; j < n_interventions_v; j++) {
+                if (i == j) continue;
+                if (is_edge_feasible(vehicle.interventions[i], vehicle.interventions[j], instance)) {
+                    set_arc(i, j, vehicle.interventions[i], vehicle.interventions[j]);
+                }
+            }
+            set_arc(i, destination, vehicle.interventions[i], vehicle.depot);
+        }
+        return;
+    }
+    // Successors of a node, restricted to the interventions of the vehicle
+    auto add_successors = [&](int true_node, int node) {
+        for (int k = instance.successors_start[true_node]; k < instance.successors_start[true_node + 1]; k++) {
+            int j = vehicle.reverse_interventions[instance.successors[k]];
+            if (j >= 0) {
+                set_arc(node, j, true_node, instance.successors[k]);
+            }
+        }
+    };
+    add_successors(vehicle.depot, origin);
+    for (int i = 0; i < n_interventions_v; i++) {
+        add_successors(vehicle.interventions[i], i);
+        set_arc(i, destination, vehicle.interventions[i], vehicle.depot);
+    }
+}
+
+
+// Removes the arcs forbidden for a vehicle from a pricing problem built on node_vehicle (see set_pricing_arcs)
+// The graph of the problem may be shared : the other problems keep the arcs
+void remove_forbidden_arcs(Problem& problem, const Vehicle& node_vehicle, const Vehicle& vehicle) {
+    auto node_index = [&](int true_node, int depot_index) {
+        return true_node == node_vehicle.depot ? depot_index : node_vehicle.reverse_interventions[true_node];
+    };
+    for (const auto& [true_i, true_j] : vehicle.forbidden_arcs) {
+        int i = node_index(true_i, problem.getOrigin());
+        int j = node_index(true_j, problem.getDestination());
+        if (i >= 0 && j >= 0) {
+            problem.removeNetworkArc(i, j);
+        }
+    }
+}
+
+
+// Passes the subset row cuts of the dual solution to a pricing problem built on node_vehicle (see set_pricing_arcs)
+// Pathwyse minimises minus the reduced cost in the maximisation formulation and the reduced cost in the minimisation one :
+// the duals are paid with the sign that decreases the reduced cost of the routes (see subset_row_penalty)
+// The memories only keep the interventions of the vehicle, the other ones are never visited
+void set_pricing_subset_row_cuts(Problem& problem, const DualSolution& dual_solution, const Vehicle& node_vehicle, bool use_maximisation_formulation) {
+    problem.clearSubsetRowCuts();
+    for (const auto& [cut, sigma] : dual_solution.subset_row_duals) {
+        if (sigma == 0) continue;
+        const auto& [i, j, k] = cut;
+        vector<int> members;
+        for (int true_node : {i, j, k}) {
+            int node = node_vehicle.reverse_interventions[true_node];
+            if (node >= 0) {
+                members.push_back(node);
+            }
+        }
+        // The routes of the vehicle cover at most one intervention of the cut
+        if (members.size() < 2) continue;
+        vector<int> memory;
+        for (int true_node : subset_row_memory(cut, dual_solution)) {
+            int node = node_vehicle.reverse_interventions[true_node];
+            if (node >= 0) {
+                memory.push_back(node);
+            }
+        }
+        problem.addSubsetRowCut(members, use_maximisation_formulation ? sigma : - sigma, memory);
+    }
+}
+
+
 // Creates a pricing instance for a given vehicle
 // Adds the constraint of capacities and time windows
 // Does not initialize the objective function
@@ -61,21 +151,7 @@ unique_ptr<Problem> create_pricing_instance(
     // Begin with the arcs that go from the warehouse to the interventions
     // If there is a required edge, we only add this edge
     bool required_first_edge = false;
-    for (int i = 0; i < n_interventions_v ; i++) {
-        if (is_edge_feasible(vehicle.depot, vehicle.interventions[i], instance)) {
-            problem->setNetworkArc(origin, i);
-        }
-        // First, we add the arcs that go to other interventions
-        for (int j = 0; j < n_interventions_v; j++) {
-            if (i == j) continue;
-            //Check if the arc is feasible
-            if (is_edge_feasible(vehicle.interventions[i], vehicle.interventions[j], instance)) {
-                problem->setNetworkArc(i, j);
-            }
-        }
-        // Then, we add the arc that goes to the destination
-        problem->setNetworkArc(i, destination);
-    }
+    set_pricing_arcs(*problem, instance, vehicle, origin, destination);
 
     // Initialize the objective function
     DefaultCost* objective = new DefaultCost();
@@ -86,16 +162,16 @@ unique_ptr<Problem> create_pricing_instance(
     // Create a vector of resources for the problem
     vector<Resource<int>*> resources;  
     int nb_capacities = instance.capacities_labels.size();
-    for (const string & label : instance.capacities_labels) {
+    for (int r = 0; r < nb_capacities; r++) {
         // Create a new capacity ressource
         Capacity* capacity = new Capacity();
         capacity->initData(false, n_interventions_v + 2);
-        capacity->setName(label);
-        capacity->setUB(vehicle.capacities.at(label) + 1);
+        capacity->setName(instance.capacities_labels[r]);
+        capacity->setUB(vehicle.capacity_values[r] + 1);
         // Set the node consumptions for the ressource
         for (int i = 0; i < n_interventions_v; i++) {
             const Node& intervention = instance.nodes[vehicle.interventions[i]];
-            int consumption = intervention.quantities.at(label);
+            int consumption = intervention.quantity_values[r];
             capacity->setNodeCost(i, consumption);
         }
         resources.push_back(capacity);
@@ -154,14 +230,17 @@ void set_pricing_instance_costs(
     auto objective = dynamic_cast<DefaultCost*>(pricing_problem->getObj());
     int origin = pricing_problem->getOrigin();
     int destination = pricing_problem->getDestination();
+    // The duals of the required arcs of the vehicle are carried by the interventions
+    vector<double> alphas = vehicle_alphas(dual_solution, vehicle.id);
     // Set the costs of the arcs
     for (int i = 0; i < n_interventions_v; i++) {
         int true_i = vehicle.interventions[i];
         const Node& intervention_i = (instance.nodes[vehicle.interventions[i]]);
+        const int* distances_i = instance.distance_matrix[true_i];
         if (use_maximisation_formulation) {
-            objective->setNodeCost(i, dual_solution.alphas[true_i] - intervention_i.duration * instance.M);
+            objective->setNodeCost(i, alphas[true_i] - intervention_i.duration * instance.M);
         } else {
-            objective->setNodeCost(i, - dual_solution.alphas[true_i]);
+            objective->setNodeCost(i, - alphas[true_i]);
         }
         for (int j = 0; j < n_interventions_v; j++) {
             if (i == j) continue;
@@ -169,7 +248,7 @@ void set_pricing_instance_costs(
             // Get the intervention referenced by the index j
             const Node& intervention_j = instance.nodes[vehicle.interventions[j]];
             // Get the distance between the two interventions
-            int distance = instance.distance_matrix[true_i][true_j];
+            int distance = distances_i[true_j];
             double arc_cost = instance.cost_per_km * distance;
             // Arc costs are counted positively in both formulations
             objective->setArcCost(i, j, arc_cost);
@@ -177,9 +256,10 @@ void set_pricing_instance_costs(
         // Arcs to / from the warehouse
         int distance_out = instance.distance_matrix[vehicle.depot][true_i];
         objective->setArcCost(origin, i, instance.cost_per_km * distance_out);
-        int distance_in = instance.distance_matrix[true_i][vehicle.depot];
+        int distance_in = distances_i[vehicle.depot];
         objective->setArcCost(i, destination, instance.cost_per_km * distance_in);
     }
+    set_pricing_subset_row_cuts(*pricing_problem, dual_solution, vehicle, use_maximisation_formulation);
     // Put in the fixed costs of the vehicle
     if (vehicle.id == -1) {
         return;
@@ -195,30 +275,34 @@ void set_pricing_instance_costs(
 }
 
 
-Route solve_pricing_problem(
-    const Instance &instance, 
+// Solves an already built pricing problem with Pathwyse
+// node_vehicle defines the indexing of the nodes of the problem, vehicle is the vehicle the route is priced for
+// (both are the same, except when the problem is built on a virtual vehicle)
+Route solve_pricing_instance(
+    Problem & pricing_problem,
+    const Instance &instance,
+    const Vehicle &node_vehicle,
     const Vehicle &vehicle,
-    const DualSolution &dual_solution,
     bool use_maximisation_formulation,
-    bool use_cyclic_pricing,
-    int n_res_dom
+    int n_res_dom,
+    const SolverConfig &config
     ) {
-    // Create the pricing problem
-    unique_ptr<Problem> pricing_problem = create_pricing_instance(instance, vehicle, use_cyclic_pricing);
-    set_pricing_instance_costs(pricing_problem, dual_solution, instance, vehicle, use_maximisation_formulation);
-    // Solve the pricing problem
-    Solver solver = Solver();
-    solver.setCustomProblem(*pricing_problem, true);
+    // The problem may have been solved before
+    pricing_problem.setStatus(PROBLEM_INDETERMINATE);
+    Solver solver = Solver(config);
+    solver.setCustomProblem(pricing_problem, true);
     solver.setupAlgorithms();
     // Set the dominance test
     if(n_res_dom == -1) {
-        n_res_dom = pricing_problem->getNumRes();
+        n_res_dom = pricing_problem.getNumRes();
     }
     dynamic_cast<PWDefault*>(solver.getMainAlgorithm())->setNResourceDomLM(n_res_dom);
     solver.solve();
-    // If the problem is indeterminate (time limit reached, we return an empty vector)
+    // If the problem is indeterminate (time limit reached, or no route found by a heuristic), we return an empty vector
     if (solver.getProblem()->getStatus() == PROBLEM_INDETERMINATE) {
-        cout << "Time limit reached for vehicle " << vehicle.id << endl;
+        if (config.main_algorithm_name == "PWDefault") {
+            cout << "Time limit reached for vehicle " << vehicle.id << endl;
+        }
         return EmptyRoute(instance.nodes.size());
     }
     // Else, if the problem is infeasible, we return an empty vector
@@ -240,8 +324,29 @@ Route solve_pricing_problem(
     if (!path.isElementary()) {
         cout << "Vehicle " << vehicle.id << " : Path is not elementary" << endl;
     }
-    
-    return convert_sequence_to_route(reduced_cost, tour, instance, vehicle);
+
+    Route route = convert_sequence_to_route(reduced_cost, tour, instance, node_vehicle);
+    // Update the route with the real vehicle id & cost (no-op if the problem is built on the vehicle itself)
+    route.vehicle_id = vehicle.id;
+    route.total_cost += vehicle.cost - node_vehicle.cost;
+    return route;
+}
+
+
+Route solve_pricing_problem(
+    const Instance &instance, 
+    const Vehicle &vehicle,
+    const DualSolution &dual_solution,
+    bool use_maximisation_formulation,
+    bool use_cyclic_pricing,
+    int n_res_dom,
+    const SolverConfig &config
+    ) {
+    // Create the pricing problem
+    unique_ptr<Problem> pricing_problem = create_pricing_instance(instance, vehicle, use_cyclic_pricing);
+    set_pricing_instance_costs(pricing_problem, dual_solution, instance, vehicle, use_maximisation_formulation);
+    // Solve the pricing problem
+    return solve_pricing_instance(*pricing_problem, instance, vehicle, vehicle, use_maximisation_formulation, n_res_dom, config);
 }
 
 
@@ -307,33 +412,33 @@ Vehicle create_virtual_vehicle(const Instance & instance, const std::vector<int>
     set<int> all_interventions;
     set<int> depots;
     map<std::string, int> all_capacities = instance.vehicles[vehicle_indexes[0]].capacities;
+    vector<int> all_capacity_values = instance.vehicles[vehicle_indexes[0]].capacity_values;
     for (int v : vehicle_indexes) {
         depots.insert(instance.vehicles[v].depot);
         all_interventions.insert(instance.vehicles[v].interventions.begin(), instance.vehicles[v].interventions.end());
         for (const auto& [label, capacity] : instance.vehicles[v].capacities) {
             all_capacities[label] = std::max(all_capacities[label], capacity);
         }
+        for (int r = 0; r < all_capacity_values.size(); r++) {
+            all_capacity_values[r] = std::max(all_capacity_values[r], instance.vehicles[v].capacity_values[r]);
+        }
     }
     if (depots.size() != 1) {
         std::cerr << "All vehicles need to have the same depot" << endl;
         return {};
     }
-    vector<int> all_interventions_v;
-    map<int, int> reverse_interventions;
-    for (int i : all_interventions) {
-        all_interventions_v.push_back(i);
-        reverse_interventions[i] = all_interventions_v.size() - 1;
-    }
     Vehicle virtual_vehicle = Vehicle{
         -1, // Fake id
         {}, // Technicians are not needed
         {}, // Skills are not needed
-        all_interventions_v,
-        reverse_interventions,
+        {}, // Interventions are set below
+        {},
         *depots.begin(),
         all_capacities,
         0 // Fake cost
     };
+    set_vehicle_interventions(virtual_vehicle, vector<int>(all_interventions.begin(), all_interventions.end()), instance.number_interventions);
+    virtual_vehicle.capacity_values = all_capacity_values;
     return virtual_vehicle;
 }
 
@@ -546,4 +651,168 @@ std::vector<Route> solve_pricing_problem_pulse_grouped_par(
     }
 
     return new_routes;
-}
\ No newline at end of file
+}
+
+SharedPricingProblems create_shared_pricing_instances(
+    const Instance& instance,
+    const std::vector<int>& vehicle_indexes,
+    bool use_cyclic_pricing
+    ) {
+    using std::make_shared, std::shared_ptr;
+    SharedPricingProblems shared_problems;
+    shared_problems.vehicle_indexes = vehicle_indexes;
+    shared_problems.virtual_vehicle = create_virtual_vehicle(instance, vehicle_indexes);
+    const Vehicle& virtual_vehicle = shared_problems.virtual_vehicle;
+
+    int n_interventions_v = virtual_vehicle.interventions.size();
+    int n_nodes = n_interventions_v + 2;
+    int origin = n_interventions_v;
+    int destination = origin + 1;
+    int depot = virtual_vehicle.depot;
+
+    // The graph is built once on the union of the interventions, and shared by all the problems of the group
+    Problem base_problem = Problem("base", n_nodes, origin, destination, 0, use_cyclic_pricing, false, true);
+    base_problem.initProblem();
+    set_pricing_arcs(base_problem, instance, virtual_vehicle, origin, destination);
+
+    // The arc costs, travel times and node consumptions are also shared
+    auto objective_data = make_shared<ResourceDataMatrix<double>>(n_nodes);
+    auto time_data = make_shared<ResourceDataMatrix<int>>(n_nodes);
+    // Capacities only have node consumptions
+    vector<shared_ptr<ResourceData<int>>> capacities_data;
+    for (int r = 0; r < instance.capacities_labels.size(); r++) {
+        auto capacity_data = make_shared<ResourceDataMap<int>>(n_nodes);
+        for (int i = 0; i < n_interventions_v; i++) {
+            const Node& intervention = instance.nodes[virtual_vehicle.interventions[i]];
+            capacity_data->setNodeCost(i, intervention.quantity_values[r]);
+        }
+        capacities_data.push_back(capacity_data);
+    }
+    for (int i = 0; i < n_interventions_v; i++) {
+        int true_i = virtual_vehicle.interventions[i];
+        time_data->setNodeCost(i, instance.nodes[true_i].duration);
+        for (int j = 0; j < n_interventions_v; j++) {
+            if (i == j) continue;
+            int true_j = virtual_vehicle.interventions[j];
+            objective_data->setArcCost(i, j, instance.cost_per_km * instance.distance_matrix[true_i][true_j]);
+            time_data->setArcCost(i, j, instance.time_matrix[true_i][true_j]);
+        }
+        // Arcs to/from the warehouse
+        objective_data->setArcCost(origin, i, instance.cost_per_km * instance.distance_matrix[depot][true_i]);
+        objective_data->setArcCost(i, destination, instance.cost_per_km * instance.distance_matrix[true_i][depot]);
+        time_data->setArcCost(origin, i, instance.time_matrix[depot][true_i]);
+        time_data->setArcCost(i, destination, instance.time_matrix[true_i][depot]);
+    }
+
+    // Then, one light problem per vehicle
+    for (int v : vehicle_indexes) {
+        const Vehicle& vehicle = instance.vehicles[v];
+        Problem* problem = new Problem(
+            std::to_string(vehicle.id),
+            n_nodes,
+            origin,
+            destination,
+            0,
+            use_cyclic_pricing,
+            false,
+            true
+        );
+        problem->initSharedProblem(base_problem);
+        remove_forbidden_arcs(*problem, virtual_vehicle, vehicle);
+        // Restrict the shared graph to the interventions of the vehicle
+        Bitset node_mask = Bitset(n_nodes);
+        auto available_interventions = get_available_interventions(vehicle, virtual_vehicle);
+        for (int i = 0; i < n_nodes; i++) {
+            if (available_interventions[i]) node_mask.set(i);
+        }
+        problem->setNodeMask(node_mask);
+
+        // The objective node costs are set in solve_shared_pricing_problem
+        DefaultCost* objective = new DefaultCost();
+        objective->initSharedData(objective_data, n_nodes);
+        problem->setObjective(objective);
+
+        vector<Resource<int>*> resources;
+        for (int r = 0; r < instance.capacities_labels.size(); r++) {
+            const string & label = instance.capacities_labels[r];
+            Capacity* capacity = new Capacity();
+            capacity->initSharedData(capacities_data[r], n_nodes);
+            capacity->setName(label);
+            capacity->setUB(vehicle.capacity_values[r] + 1);
+            resources.push_back(capacity);
+        }
+
+        CustomTimeWindow* time_window = new CustomTimeWindow(n_nodes);
+        time_window->initSharedData(time_data, n_nodes);
+        time_window->setName("Time Window + Lunch");
+        for (int i = 0; i < n_interventions_v; i++) {
+            const Node& intervention_i = instance.nodes[virtual_vehicle.interventions[i]];
+            int start_window = intervention_i.start_window;
+            int end_window = intervention_i.end_window - intervention_i.duration;
+            time_window->setNodeBound(n_nodes, i, start_window, end_window);
+            time_window->setLunchConstraint(i, intervention_i.is_ambiguous);
+        }
+        time_window->setNodeBound(n_nodes, origin, 0, END_DAY);
+        time_window->setNodeBound(n_nodes, destination, 0, END_DAY);
+        time_window->init(origin, destination);
+        resources.push_back(time_window);
+
+        problem->setResources(resources);
+        shared_problems.problems.push_back(unique_ptr<Problem>(problem));
+    }
+
+    return shared_problems;
+}
+
+
+std::vector<SharedPricingProblems> create_shared_pricing_groups(
+    const Instance& instance,
+    const std::vector<int>& vehicle_indexes,
+    bool use_cyclic_pricing
+    ) {
+    std::map<int, vector<int>> vehicles_by_depot;
+    for (int v : vehicle_indexes) {
+        vehicles_by_depot[instance.vehicles.at(v).depot].push_back(v);
+    }
+    vector<SharedPricingProblems> groups;
+    for (const auto& [depot, group_vehicles] : vehicles_by_depot) {
+        groups.push_back(create_shared_pricing_instances(instance, group_vehicles, use_cyclic_pricing));
+    }
+    return groups;
+}
+
+
+Route solve_shared_pricing_problem(
+    SharedPricingProblems & shared_problems,
+    int k,
+    const Instance &instance,
+    const DualSolution &dual_solution,
+    bool use_maximisation_formulation,
+    int n_res_dom,
+    const SolverConfig &config
+    ) {
+    const Vehicle& virtual_vehicle = shared_problems.virtual_vehicle;
+    const Vehicle& vehicle = instance.vehicles[shared_problems.vehicle_indexes[k]];
+    Problem& pricing_problem = *shared_problems.problems[k];
+
+    // Only the node costs are set, the arc costs are shared
+    // The duals of the required arcs of the vehicle are carried by the interventions
+    auto objective = pricing_problem.getObj();
+    vector<double> alphas = vehicle_alphas(dual_solution, vehicle.id);
+    for (int i = 0; i < virtual_vehicle.interventions.size(); i++) {
+        int true_i = virtual_vehicle.interventions[i];
+        if (use_maximisation_formulation) {
+            objective->setNodeCost(i, alphas[true_i] - instance.nodes[true_i].duration * instance.M);
+        } else {
+            objective->setNodeCost(i, - alphas[true_i]);
+        }
+    }
+    if (use_maximisation_formulation) {
+        objective->setNodeCost(pricing_problem.getOrigin(), dual_solution.betas[vehicle.id] + vehicle.cost);
+    } else {
+        objective->setNodeCost(pricing_problem.getOrigin(), - dual_solution.betas[vehicle.id] + vehicle.cost);
+    }
+    set_pricing_subset_row_cuts(pricing_problem, dual_solution, virtual_vehicle, use_maximisation_formulation);
+
+    return solve_pricing_instance(pricing_problem, instance, virtual_vehicle, vehicle, use_maximisation_formulation, n_res_dom, config);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../pathwyse/core/data/problem.h"
+#include "../../pathwyse/core/utils/param.h"
 #include "instance/instance.h"
 #include "routes/route.h"
 #include "master_problem/master.h"
@@ -13,13 +14,58 @@
 
 
 // Solve the pricing problem for a given vehicle using the basic Pathwyse algorithm
+// The solver is built from the given configuration (by default, a snapshot of the global Pathwyse parameters)
 Route solve_pricing_problem(
     const Instance &instance, 
     const Vehicle &vehicle,
     const DualSolution &dual_solution,
     bool use_maximisation_formulation,
     bool use_cyclic_pricing = false,
-    int n_res_dom = -1
+    int n_res_dom = -1,
+    const SolverConfig &config = SolverConfig()
+    );
+
+
+// Pricing problems of a group of vehicles sharing the same depot
+// The graph and the arc data are built once on the union of the interventions of the group (the virtual vehicle)
+// Each problem only owns its node mask, its node costs and its node bounds
+struct SharedPricingProblems {
+    // Virtual vehicle defining the node indexing of all the problems
+    Vehicle virtual_vehicle;
+    // Indexes of the vehicles of the group, in the same order as the problems
+    std::vector<int> vehicle_indexes;
+    std::vector<std::unique_ptr<Problem>> problems;
+};
+
+
+// Creates the pricing problems of a group of vehicles sharing the same depot
+// The costs of the objective are not set (see solve_shared_pricing_problem)
+SharedPricingProblems create_shared_pricing_instances(
+    const Instance& instance,
+    const std::vector<int>& vehicle_indexes,
+    bool use_cyclic_pricing
+    );
+
+
+// Creates the pricing problems of the given vehicles, one group of shared problems per depot
+std::vector<SharedPricingProblems> create_shared_pricing_groups(
+    const Instance& instance,
+    const std::vector<int>& vehicle_indexes,
+    bool use_cyclic_pricing
+    );
+
+
+// Solve the pricing problem of the k-th vehicle of a group created by create_shared_pricing_instances
+// Different k can be solved in parallel : the shared data is only read
+// The problems can be solved again with other duals : the resource bounds computed by Pathwyse are kept
+Route solve_shared_pricing_problem(
+    SharedPricingProblems & shared_problems,
+    int k,
+    const Instance &instance,
+    const DualSolution &dual_solution,
+    bool use_maximisation_formulation,
+    int n_res_dom = -1,
+    const SolverConfig &config = SolverConfig()
     );
 
 
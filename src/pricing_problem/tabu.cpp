@@ -1,241 +1,201 @@
 #include "tabu.h"
 
-#include "instance/constants.h"
-#include "gurobi_c++.h"
-
-
-std::vector<int> local_matrix_to_seq(const std::vector<std::vector<int>> & matrix, const Vehicle & vehicle){
-    std::vector<int> sequence;
-    int reduced_size = vehicle.interventions.size() + 1;
-    int reduced_depot = vehicle.interventions.size();
-
-    int current_reduced = reduced_depot;
-    sequence.push_back(vehicle.depot);
-    bool depot_reached = false;
-    while (!depot_reached){
-        int next = -1;
-        for (int i = 0; i < reduced_size; i++){
-            if (matrix[current_reduced][i] == 1){
-                next = i;
-                break;
-            }
-        }
-        if (next == reduced_depot){
-            depot_reached = true;
-            sequence.push_back(vehicle.depot);
-        } else {
-            sequence.push_back(vehicle.interventions[next]);
-            current_reduced = next;
-        }
-    }
+#include "routes/route_evaluation.h"
+#include "master_problem/subset_row_cuts.h"
 
-    return sequence;
-}
+#include <vector>
+#include <set>
+#include <limits>
+#include <algorithm>
 
-std::vector<std::vector<int>> local_matrix_to_global(
-    const std::vector<std::vector<int>> & matrix, 
-    const Vehicle & vehicle, 
-    const Instance & instance){
-    std::vector<std::vector<int>> global_matrix(instance.nodes.size(), std::vector<int>(instance.nodes.size(), 0));
-
-    int reduced_size = vehicle.interventions.size() + 1;
-    int reduced_depot = vehicle.interventions.size();
-
-    for (int i = 0; i < reduced_size; i++){
-        for (int j = 0; j < reduced_size; j++){
-            if (matrix[i][j] == 1){
-                int true_i = i == reduced_depot ? vehicle.depot : vehicle.interventions[i];
-                int true_j = j == reduced_depot ? vehicle.depot : vehicle.interventions[j];
-                global_matrix[true_i][true_j] = 1;
-            }
-        }
-    }
 
-    return global_matrix;
-}
+// Threshold under which a reduced cost is considered improving
+inline constexpr double TABU_RC_THRESHOLD = 1e-6;
 
-std::vector<int> sequence_to_mask(const std::vector<int> & sequence, const Vehicle & vehicle, const Instance & instance){
-    std::vector<int> mask(instance.nodes.size(), 0);
-    for (int i : sequence){
-        mask[i] = 1;
-    }
-    return mask;
-}
+
+// Move of the tabu search
+struct TabuMove {
+    enum Type {NONE, INSERT, REMOVE, REPLACE, TWO_OPT};
+    Type type = NONE;
+    // Position in the sequence (first position of the reversed segment for 2-opt)
+    int position = -1;
+    // Intervention inserted (last position of the reversed segment for 2-opt)
+    int intervention = -1;
+    // Variation of the cost of the route
+    double delta = std::numeric_limits<double>::infinity();
+};
 
 
 std::vector<Route> tabu_search(
     const Route & initial_route,
     int max_iterations,
-    int max_modifications,
+    int tabu_tenure,
     const DualSolution & solution,
     const Vehicle & vehicle,
-    const Instance & instance
+    const Instance & instance,
+    bool use_maximisation_formulation
 ){
     using std::vector;
 
-    int n_interventions = vehicle.interventions.size();
-    int n_nodes = vehicle.interventions.size() + 1;
-    int reduced_depot = vehicle.interventions.size(); // The depot is the last node (in the reduced graph)
-
-    // Initialize the tabu list
-    vector<Route> tabu_list = {initial_route};
-    Route previous_route = initial_route;
-
-    // Create the model
-    GRBEnv env = GRBEnv(true);
-    env.set(GRB_IntParam_OutputFlag, 0);
-    env.start();
-    GRBModel model = GRBModel(env);
-    // Create the variables
-    vector<vector<GRBVar>> x(n_nodes, vector<GRBVar>(n_nodes));
-    for (int i = 0; i < n_nodes; i++){
-        for (int j = 0; j < n_nodes; j++){
-            x[i][j] = model.addVar(0.0, 1.0, 0.0, GRB_BINARY);
+    // The search minimizes the cost of the route : fixed cost + travel cost - sum of the gains of the interventions
+    // The reduced cost is this cost in the minimisation formulation, and its opposite in the maximisation formulation
+    vector<double> gains(instance.nodes.size(), 0);
+    vector<double> alphas = vehicle_alphas(solution, vehicle.id);
+    for (int i : vehicle.interventions){
+        if (use_maximisation_formulation){
+            gains[i] = instance.M * instance.nodes[i].duration - alphas[i];
+        } else {
+            gains[i] = alphas[i];
         }
     }
-    vector<GRBVar> u(n_interventions);
-    for (int i = 0; i < n_interventions; i++){
-        u[i] = model.addVar(0.0, n_nodes, 0.0, GRB_INTEGER);
-    }
-    vector<GRBVar> z(n_interventions);
-    for (int i = 0; i < n_interventions; i++){
-        z[i] = model.addVar(0.0, 1.0, 0.0, GRB_BINARY);
-    }
-    // Constraints
-    // Flow conservation
-    for (int i = 0; i < n_interventions; i++){
-        model.addConstr(x[i][i] <= 0);
-        GRBLinExpr flow_in = 0;
-        GRBLinExpr flow_out = 0;
-        for (int j = 0; j < n_nodes; j++){
-            flow_in += x[j][i];
-            flow_out += x[i][j];
+    double fixed_cost = vehicle.cost + (use_maximisation_formulation ? solution.betas[vehicle.id] : - solution.betas[vehicle.id]);
+    auto route_cost = [&](const RouteSchedule& schedule){
+        double cost = fixed_cost + instance.cost_per_km * schedule.distance;
+        for (int k = 1; k < (int) schedule.sequence.size() - 1; k++){
+            cost -= gains[schedule.sequence[k]];
         }
-        model.addConstr(flow_in - flow_out == 0);
-    }
-    // Depot constraint
-    GRBLinExpr depot_in = 0;
-    GRBLinExpr depot_out = 0;
-    for (int i = 0; i < n_interventions; i++){
-        depot_in += x[i][reduced_depot];
-        depot_out += x[reduced_depot][i];
-    }
-    model.addConstr(depot_in == 1);
-    model.addConstr(depot_out == 1);
-    // Subtour elimination is handled by the next constraints
-    // Time window constraints
-    for (int i = 0; i < n_interventions; i++){
-        int start_window = instance.nodes[vehicle.interventions[i]].start_window;
-        int duration = instance.nodes[vehicle.interventions[i]].duration;
-        int end_window = instance.nodes[vehicle.interventions[i]].end_window;
-        for (int j = 0; j < n_interventions; j++){
-            int time = instance.time_matrix[vehicle.interventions[i]][vehicle.interventions[j]];
-            model.addConstr(u[i] - end_window + (end_window + duration + time) * x[i][j] <= u[j]);
+        // The subset row cuts depend on the whole route : the moves are evaluated without them
+        if (!solution.subset_row_duals.empty()){
+            double penalty = subset_row_penalty(schedule.sequence, solution);
+            cost += use_maximisation_formulation ? penalty : - penalty;
         }
-        model.addConstr(start_window <= u[i]);
-        model.addConstr(u[i] + duration <= end_window);
-        model.addConstr(u[i] >= MID_DAY * z[i]);
-        model.addConstr(u[i] + duration <= MID_DAY + (END_DAY - MID_DAY) * z[i]);
+        return cost;
+    };
+
+    // Current route
+    vector<int> sequence = initial_route.id_sequence;
+    if (sequence.size() < 2){
+        sequence = {vehicle.depot, vehicle.depot};
     }
-    // Depot time window constraints
-    for (int i = 0; i < n_interventions; i++){
-        int time_out = instance.time_matrix[vehicle.interventions[i]][vehicle.depot];
-        model.addConstr(time_out * x[reduced_depot][i] <= MID_DAY);
-        int duration = instance.nodes[vehicle.interventions[i]].duration;
-        int time_in = instance.time_matrix[vehicle.depot][vehicle.interventions[i]];
-        model.addConstr(u[i] + duration + time_in * x[i][reduced_depot] <= END_DAY);
+    RouteSchedule schedule = schedule_route(sequence, instance, vehicle);
+    if (!schedule.is_feasible){
+        schedule = schedule_route({vehicle.depot, vehicle.depot}, instance, vehicle);
     }
-    // Objective function
-    GRBLinExpr obj = 0;
-    for (int i = 0; i < n_nodes; i++){
-        for (int j = 0; j < n_nodes; j++){
-            int true_i = i == reduced_depot ? vehicle.depot : vehicle.interventions[i];
-            int true_j = j == reduced_depot ? vehicle.depot : vehicle.interventions[j];
-            obj -= instance.time_matrix[true_i][true_j] * x[i][j] * instance.cost_per_km;
-            obj += instance.nodes[true_i].duration * x[i][j] * instance.M;
-            obj -= solution.alphas[true_i] * x[i][j];
-        }
+    double cost = route_cost(schedule);
+    double best_cost = cost;
+
+    // Attribute based tabu memory : iteration until which an intervention can not be inserted / removed
+    vector<int> tabu_insert(instance.nodes.size(), -1);
+    vector<int> tabu_remove(instance.nodes.size(), -1);
+    vector<int> is_in_route(instance.nodes.size(), 0);
+    for (int k = 1; k < schedule.sequence.size() - 1; k++){
+        is_in_route[schedule.sequence[k]] = 1;
     }
 
-    model.setObjective(obj, GRB_MAXIMIZE);
-
-    // Warm start with the initial route
-    for (int i = 0; i < previous_route.id_sequence.size() - 1; i++){
-        int true_i = previous_route.id_sequence[i];
-        int true_j = previous_route.id_sequence[i + 1];
-        int reduced_i = true_i == vehicle.depot ? reduced_depot : vehicle.reverse_interventions.at(true_i);
-        int reduced_j = true_j == vehicle.depot ? reduced_depot : vehicle.reverse_interventions.at(true_j);
-        x[reduced_i][reduced_j].set(GRB_DoubleAttr_Start, 1.0);
-    }
+    // Improving routes found, by increasing cost
+    vector<std::pair<double, vector<int>>> found;
+    std::set<vector<int>> found_sequences;
+    auto record = [&](){
+        if (cost >= - TABU_RC_THRESHOLD || found_sequences.contains(schedule.sequence)){
+            return;
+        }
+        found_sequences.insert(schedule.sequence);
+        found.push_back({cost, schedule.sequence});
+    };
+    record();
+
+    for (int iteration = 0; iteration < max_iterations; iteration++){
+        int n = schedule.sequence.size();
+        TabuMove best_move;
+        auto consider = [&](TabuMove move, bool is_tabu){
+            // Aspiration : a tabu move is allowed if it gives the best route found so far
+            if (is_tabu && cost + move.delta >= best_cost - TABU_RC_THRESHOLD){
+                return;
+            }
+            if (move.delta < best_move.delta){
+                best_move = move;
+            }
+        };
 
-    // Tabu search loop
-    int iteration = 0;
-    while( previous_route.reduced_cost > 1e-6 && iteration < max_iterations) {
-        // Add the "no good cuts" constraint relative to the previous route
-        GRBLinExpr no_good_cuts = 0;
-        for (int i = 0; i < n_nodes; i++){
-            for (int j = 0; j < n_nodes; j++){
-                int true_i = i == reduced_depot ? vehicle.depot : vehicle.interventions[i];
-                int true_j = j == reduced_depot ? vehicle.depot : vehicle.interventions[j];
-                if (previous_route.route_edges[true_i][true_j] == 0){
-                    no_good_cuts += x[i][j];
-                } else {
-                    no_good_cuts += 1 - x[i][j];
+        for (int u : vehicle.interventions){
+            if (is_in_route[u]){
+                continue;
+            }
+            bool tabu_u = tabu_insert[u] > iteration;
+            // Insertions
+            for (int p = 1; p < n; p++){
+                double delta = instance.cost_per_km * insertion_distance(schedule, p, u, instance) - gains[u];
+                if (delta < best_move.delta && is_insertion_feasible(schedule, p, u, instance, vehicle)){
+                    consider({TabuMove::INSERT, p, u, delta}, tabu_u);
                 }
             }
-        }
-        model.addConstr(no_good_cuts >= 1);
-        // Add the "at most K modifications" constraint
-        // auto modifications = model.addConstr(no_good_cuts <= max_modifications);
-        // Optimize
-        model.optimize();
-        try {
-            // Extract the solution
-            double obj_val = model.get(GRB_DoubleAttr_ObjVal);
-            // Extract the local edge matrix
-            vector<vector<int>> local_matrix(n_nodes, vector<int>(n_nodes, 0));
-            for (int i = 0; i < n_nodes; i++){
-                for (int j = 0; j < n_nodes; j++){
-                    local_matrix[i][j] = x[i][j].get(GRB_DoubleAttr_X);
+            // Replacements
+            for (int p = 1; p < n - 1; p++){
+                int removed = schedule.sequence[p];
+                double delta = instance.cost_per_km * replacement_distance(schedule, p, u, instance) - gains[u] + gains[removed];
+                if (delta < best_move.delta && is_replacement_feasible(schedule, p, u, instance, vehicle)){
+                    consider({TabuMove::REPLACE, p, u, delta}, tabu_u || tabu_remove[removed] > iteration);
                 }
             }
-            // Convert the local matrix to a sequence
-            vector<int> sequence = local_matrix_to_seq(local_matrix, vehicle);
-            // Convert the local matrix to a global matrix
-            vector<vector<int>> global_matrix = local_matrix_to_global(local_matrix, vehicle, instance);
-            // Also get the covered interventions
-            vector<int> is_in_route = sequence_to_mask(sequence, vehicle, instance);
-            // Compute the reduced cost
-            double reduced_cost = obj_val - vehicle.cost - solution.betas[vehicle.id];
-            Route new_route = Route{
-                vehicle.id,
-                -1,
-                reduced_cost,
-                -1,
-                sequence,
-                is_in_route,
-                global_matrix
-            };
-            // Update the route cost and duration
-            new_route.total_cost = count_route_kilometres(new_route, instance) * instance.cost_per_km + vehicle.cost;
-            new_route.total_duration = count_route_duration(new_route, instance);
-
-            // Update the tabu list & previous route
-            if (new_route.reduced_cost > 1e-6){
-                tabu_list.push_back(new_route);
+        }
+        // Removals
+        for (int p = 1; p < n - 1; p++){
+            int removed = schedule.sequence[p];
+            double delta = instance.cost_per_km * removal_distance(schedule, p, instance) + gains[removed];
+            if (delta < best_move.delta && is_removal_feasible(schedule, p, instance)){
+                consider({TabuMove::REMOVE, p, -1, delta}, tabu_remove[removed] > iteration);
             }
-            previous_route = new_route;
-        } catch (GRBException e) {
-            std::cout << "Error code = " << e.getErrorCode() << std::endl;
-            std::cout << e.getMessage() << std::endl;
+        }
+        // 2-opt, only when it shortens the route (the set of interventions does not change)
+        if (best_move.delta >= 0){
+            for (int i = 1; i < n - 2 && best_move.type != TabuMove::TWO_OPT; i++){
+                for (int j = i + 1; j < n - 1; j++){
+                    vector<int> candidate = schedule.sequence;
+                    std::reverse(candidate.begin() + i, candidate.begin() + j + 1);
+                    RouteSchedule candidate_schedule = schedule_route(candidate, instance, vehicle);
+                    double delta = instance.cost_per_km * (candidate_schedule.distance - schedule.distance);
+                    if (delta < 0 && candidate_schedule.is_feasible){
+                        best_move = {TabuMove::TWO_OPT, i, j, delta};
+                        break;
+                    }
+                }
+            }
+        }
+        if (best_move.type == TabuMove::NONE){
+            break;
         }
 
-        // Remove the modifications constraint
-        // model.remove(modifications);
-
-        iteration++;
+        // Apply the move and update the tabu memory
+        vector<int> new_sequence = schedule.sequence;
+        if (best_move.type == TabuMove::INSERT){
+            new_sequence.insert(new_sequence.begin() + best_move.position, best_move.intervention);
+            is_in_route[best_move.intervention] = 1;
+            tabu_remove[best_move.intervention] = iteration + tabu_tenure;
+        } else if (best_move.type == TabuMove::REMOVE){
+            int removed = new_sequence[best_move.position];
+            new_sequence.erase(new_sequence.begin() + best_move.position);
+            is_in_route[removed] = 0;
+            tabu_insert[removed] = iteration + tabu_tenure;
+        } else if (best_move.type == TabuMove::REPLACE){
+            int removed = new_sequence[best_move.position];
+            new_sequence[best_move.position] = best_move.intervention;
+            is_in_route[removed] = 0;
+            is_in_route[best_move.intervention] = 1;
+            tabu_insert[removed] = iteration + tabu_tenure;
+            tabu_remove[best_move.intervention] = iteration + tabu_tenure;
+        } else {
+            std::reverse(new_sequence.begin() + best_move.position, new_sequence.begin() + best_move.intervention + 1);
+        }
+        schedule = schedule_route(new_sequence, instance, vehicle);
+        cost = route_cost(schedule);
+        best_cost = std::min(best_cost, cost);
+        record();
     }
 
-    return tabu_list;
-
-}
\ No newline at end of file
+    // Keep the best routes, converted to in-vehicle indices
+    std::sort(found.begin(), found.end());
+    if (found.size() > TABU_MAX_ROUTES){
+        found.resize(TABU_MAX_ROUTES);
+    }
+    vector<Route> routes;
+    for (const auto& [found_cost, route_sequence] : found){
+        vector<int> vehicle_sequence = {-1};
+        for (int k = 1; k < route_sequence.size() - 1; k++){
+            vehicle_sequence.push_back(vehicle.reverse_interventions[route_sequence[k]]);
+        }
+        vehicle_sequence.push_back(-1);
+        double reduced_cost = use_maximisation_formulation ? - found_cost : found_cost;
+        routes.push_back(convert_sequence_to_route(reduced_cost, vehicle_sequence, instance, vehicle));
+    }
+    return routes;
+}
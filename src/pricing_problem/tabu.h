@@ -5,11 +5,24 @@
 
 #include <vector>
 
+// Maximum number of routes returned by the tabu search of a vehicle (the ones with the best reduced costs)
+inline constexpr int TABU_MAX_ROUTES = 10;
+
+
+// Tabu search for routes of negative reduced cost (positive in the maximisation formulation) for a single vehicle
+// Works directly on the sequence of interventions, starting from the initial route (or from the empty route)
+// Moves : insertion, removal and replacement of an intervention (evaluated in constant time, see route_evaluation.h)
+// and 2-opt reversals, that are only applied when they shorten the route
+// The best admissible move is applied at each iteration, even if it worsens the reduced cost
+// Tabu memory : an intervention removed from the route can not be inserted back, and an inserted intervention can not be
+// removed, during tabu_tenure iterations, unless the move gives the best reduced cost found so far
+// Returns the distinct improving routes found, at most TABU_MAX_ROUTES
 std::vector<Route> tabu_search(
     const Route & initial_route,
     int max_iterations,
-    int max_modifications,
+    int tabu_tenure,
     const DualSolution & solution,
     const Vehicle & vehicle,
-    const Instance & instance
-);
\ No newline at end of file
+    const Instance & instance,
+    bool use_maximisation_formulation
+);
@@ -51,14 +51,15 @@ int CustomTimeWindow::extend(int current_value, int i, int j, bool direction) {
         }
     }
     else {
-        current_time += data->getArcCost(i, j);
-        // If this departure time from i is too late, it means we wait after the time window closes
+        current_time += data->getArcCost(i, j) + data->getNodeCost(i);
+        // If this start time at i is too late, it means we wait after the time window closes
+        // (node_upper_bound is the latest start time of the intervention)
         if (current_time < upper_bound - node_upper_bound[i]) {
             current_time = upper_bound - node_upper_bound[i];
         }
-        current_time += data->getNodeCost(i);
         // If this overlaps with the lunch break, we offset the time such that we do it entirely before the break
-        bool is_lunch_break = current_time >= upper_bound - MID_DAY && current_time < upper_bound - MID_DAY + data->getNodeCost(i);
+        // Starting exactly at MID_DAY does not overlap, as in the forward extension
+        bool is_lunch_break = current_time > upper_bound - MID_DAY && current_time < upper_bound - MID_DAY + data->getNodeCost(i);
         if(has_lunch_constraint[i] && is_lunch_break) {
             current_time = upper_bound - MID_DAY + data->getNodeCost(i);
         }
@@ -78,9 +79,9 @@ int CustomTimeWindow::join(int current_value_forward, int current_value_backward
 bool CustomTimeWindow::isFeasible(int current_value, int current_node, double bounding, bool direction) {
     if(current_value > upper_bound*bounding) return false;
 
-    if (node_lower_bound[current_node] > node_upper_bound[current_node]) return false;
-
     if(current_node >= 0) {
+        if (node_lower_bound[current_node] > node_upper_bound[current_node]) return false;
+
         int feasible_value = 0;
         if(direction) {
             feasible_value = node_upper_bound[current_node];
@@ -233,6 +233,60 @@ bool PulseAlgorithm::check_bounds(int vertex, int time, double cost) const {
 }
 
 
+double PulseAlgorithm::subset_row_penalty(const PartialPath & path, int vertex) const {
+    const SubsetRowCuts& cuts = problem->getSubsetRowCuts();
+    if (cuts.empty() || path.sequence.empty()) {
+        return 0;
+    }
+    // The members of a cut are in its memory : the state is not reset by the vertex
+    double penalty = 0;
+    for (int cut : cuts.getCuts(vertex)) {
+        if (cut < path.subset_rows.size() && path.subset_rows[cut]) {
+            penalty += cuts.getDual(cut);
+        }
+    }
+    return penalty;
+}
+
+
+void PulseAlgorithm::update_subset_rows(PartialPath & path, int vertex) const {
+    const SubsetRowCuts& cuts = problem->getSubsetRowCuts();
+    // The vertex was the first of the path
+    if (cuts.empty() || path.sequence.size() < 2) {
+        return;
+    }
+    path.subset_rows.resize(cuts.size(), false);
+    for (int cut : cuts.getResets(vertex)) {
+        path.subset_rows[cut] = false;
+    }
+    for (int cut : cuts.getCuts(vertex)) {
+        path.subset_rows[cut] = !path.subset_rows[cut];
+    }
+}
+
+
+double PulseAlgorithm::sequence_penalty(const std::vector<int> & sequence, int begin, int end) const {
+    const SubsetRowCuts& cuts = problem->getSubsetRowCuts();
+    if (cuts.empty()) {
+        return 0;
+    }
+    double penalty = 0;
+    std::vector<bool> states(cuts.size(), false);
+    for (int k = begin; k < end; k++) {
+        for (int cut : cuts.getResets(sequence[k])) {
+            states[cut] = false;
+        }
+        for (int cut : cuts.getCuts(sequence[k])) {
+            if (states[cut]) {
+                penalty += cuts.getDual(cut);
+            }
+            states[cut] = !states[cut];
+        }
+    }
+    return penalty;
+}
+
+
 bool PulseAlgorithm::rollback(int vertex, const PartialPath & path) const {
     // First step is checking the lenght of the path - rollback is only possible for pathes of length at least 2
     if (path.sequence.size() < 2) {
@@ -245,8 +299,13 @@ bool PulseAlgorithm::rollback(int vertex, const PartialPath & path) const {
     // - Thanks to the triangular inequality, the time along the path when removing the last vertex is lower
     // - By construction, the resource consumptions are also lower
     // - By construction, the rollback path is strictly included in the longer path
+    // - Removing a vertex does not increase the subset row duals paid, unless it resets the memory of a cut
     int v_last = path.sequence[path.sequence.size() - 1];
     int v_prev = path.sequence[path.sequence.size() - 2];
+    const SubsetRowCuts& cuts = problem->getSubsetRowCuts();
+    if (!cuts.empty() && !cuts.getResets(v_last).empty()) {
+        return false;
+    }
     // Compute the cost of going from v_prev to v directly
     int r_new = problem->getObj()->getArcCost(v_prev, vertex);
     // Compute the cost of going from v_prev to v_last and then to v
@@ -307,9 +366,17 @@ bool PulseAlgorithm::splice(const PartialPath& path, int vertex, int time, doubl
     }
     // We also update the cost
     cost += best_bound.cost;
+    // The prefix (up to the vertex) and the extension (after the vertex) paid their subset row duals separately
+    int prefix_end = path.sequence.size() + 1;
+    int path_end = new_path.sequence.size();
+    double junction_penalty = sequence_penalty(new_path.sequence, 1, path_end)
+        - sequence_penalty(new_path.sequence, 1, prefix_end)
+        - sequence_penalty(new_path.sequence, prefix_end, path_end);
+    cost += junction_penalty;
     // new_path is now a full path to the destination, we can pass it to the update_pool method
     update_pool(cost, new_path, new_quantities);
-    return true;
+    // If duals are paid at the junction, the spliced path may not be the best completion of the path anymore
+    return junction_penalty <= 0;
 }
     
 
@@ -338,6 +405,8 @@ void PulseAlgorithm::update_pool(double cost, const PartialPath & path, const st
 void PulseAlgorithm::pulse(int vertex, int time, std::vector<int>quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -360,6 +429,7 @@ void PulseAlgorithm::pulse(int vertex, int time, std::vector<int>quantities, dou
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
@@ -13,6 +13,9 @@ struct PartialPath {
     std::vector<bool> is_visited;
     std::vector<int> sequence;
     std::vector<int> start_times;
+    // States of the subset row cuts of the problem : true if the path visited an odd number of members of the cut
+    // The first vertex of the path is not counted (see PulseAlgorithm::update_subset_rows)
+    std::vector<bool> subset_rows;
 };
 
 // Return an empty path corresponding to a graph with N vertices
@@ -58,7 +61,18 @@ public :
     // If going through the last vertex in p was a mistake, we rollback the choice
     bool rollback(int vertex, const PartialPath & path) const;
 
+    // Duals of the subset row cuts paid when extending the path to the vertex
+    double subset_row_penalty(const PartialPath & path, int vertex) const;
+
+    // Update the states of the subset row cuts of a path that was just extended to the vertex
+    // The first vertex of a path is not counted, so that the bounds (computed from an empty path) stay lower bounds
+    void update_subset_rows(PartialPath & path, int vertex) const;
+
+    // Duals of the subset row cuts paid along sequence[begin:end], counted from an empty path
+    double sequence_penalty(const std::vector<int> & sequence, int begin, int end) const;
+
     // Try to splice the path with the best path in the pool, returns true if the path was spliced
+    // and no better completion of the path remains (the spliced path is still added to the pool otherwise)
     bool splice(const PartialPath & path, int vertex, int time, double cost, std::vector<int> quantities);
 
     // Main pulse algorithm
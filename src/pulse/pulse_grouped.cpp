@@ -29,6 +29,8 @@ bool PulseAlgorithmWithSubsets::is_feasible(int vertex, int time, std::vector<in
 void PulseAlgorithmWithSubsets::pulse(int vertex, int time, std::vector<int> quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -47,6 +49,7 @@ void PulseAlgorithmWithSubsets::pulse(int vertex, int time, std::vector<int> qua
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
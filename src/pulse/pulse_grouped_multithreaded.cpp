@@ -60,6 +60,8 @@ void PulseAlgorithmMultithreadedGrouped::bound() {
 void PulseAlgorithmMultithreadedGrouped::pulse(int vertex, int time, std::vector<int>quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!PulseAlgorithmWithSubsets::is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -78,6 +80,7 @@ void PulseAlgorithmMultithreadedGrouped::pulse(int vertex, int time, std::vector
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
@@ -99,6 +102,8 @@ void PulseAlgorithmMultithreadedGrouped::pulse(int vertex, int time, std::vector
 void PulseAlgorithmMultithreadedGrouped::pulse_parallel(int vertex, int time, std::vector<int> quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!PulseAlgorithmWithSubsets::is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -117,6 +122,7 @@ void PulseAlgorithmMultithreadedGrouped::pulse_parallel(int vertex, int time, st
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
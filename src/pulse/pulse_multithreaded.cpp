@@ -74,6 +74,8 @@ void PulseAlgorithmMultithreaded::update_pool(double cost, const PartialPath& pa
 void PulseAlgorithmMultithreaded::pulse(int vertex, int time, std::vector<int>quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -91,6 +93,7 @@ void PulseAlgorithmMultithreaded::pulse(int vertex, int time, std::vector<int>qu
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
@@ -112,6 +115,8 @@ void PulseAlgorithmMultithreaded::pulse(int vertex, int time, std::vector<int>qu
 void PulseAlgorithmMultithreaded::pulse_parallel(int vertex, int time, std::vector<int> quantities, double cost, const PartialPath& path) {
     using std::vector;
     using std::cout, std::endl;
+    // Pay the duals of the subset row cuts completed by the vertex
+    cost += subset_row_penalty(path, vertex);
     // Check the feasibility of the partial path
     if (!is_feasible(vertex, time, quantities, cost, path)) {
         return;
@@ -129,6 +134,7 @@ void PulseAlgorithmMultithreaded::pulse_parallel(int vertex, int time, std::vect
     }
     // Extend the path
     PartialPath p_new = extend_path(path, vertex, time);
+    update_subset_rows(p_new, vertex);
 
     // Check if we are at the destination
     if (vertex == destination) {
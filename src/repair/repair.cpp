@@ -1,5 +1,8 @@
 #include "repair.h"
 
+#include "routes/route_evaluation.h"
+#include "instance/parallel.h"
+
 #include <vector>
 #include <numeric>
 #include <algorithm>
@@ -42,45 +45,112 @@ void delete_intervention(Route& route, int intervention, const Instance& instanc
     route.total_cost += (distance_added - distance_deleted) * instance.cost_per_km;
 }
 
-void repair_routes(std::vector<Route>& routes, IntegerSolution& solution, const Instance& instance) {
+// Removes the intervention from the routes covering it, by decreasing delta, until a single route covers it
+// The removals that would make a route infeasible (the triangle inequality does not always hold) are skipped
+// The schedules of the routes are recomputed after each removal
+void remove_duplicate_covering(int intervention, const std::vector<int>& covering_routes, std::vector<Route>& routes, std::vector<RouteSchedule>& schedules, const Instance& instance){
+    using std::vector;
+    // Compute the "delta" of removing the intervention from each route, on its schedule
+    vector<int> positions(covering_routes.size());
+    vector<double> delta = vector<double>(covering_routes.size());
+    for (int r = 0; r < covering_routes.size(); r++){
+        const vector<int>& sequence = schedules[covering_routes[r]].sequence;
+        positions[r] = std::find(sequence.begin(), sequence.end(), intervention) - sequence.begin();
+        delta[r] = - removal_distance(schedules[covering_routes[r]], positions[r], instance) * instance.cost_per_km;
+    }
+    // Sort the routes by the delta
+    vector<int> indexes(covering_routes.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    std::sort(indexes.begin(), indexes.end(), [&delta](int i1, int i2) {return delta[i1] > delta[i2];});
+
+    // Remove the intervention from the routes with the highest deltas, keeping it in at least one route
+    int remaining = covering_routes.size();
+    for (int j = 0; j < indexes.size() && remaining > 1; j++){
+        int r = covering_routes[indexes[j]];
+        if (!is_removal_feasible(schedules[r], positions[indexes[j]], instance)){
+            continue;
+        }
+        delete_intervention(routes[r], intervention, instance);
+        schedules[r] = schedule_route(routes[r], instance);
+        remaining--;
+    }
+}
+
+// Representative of a route in the union-find structure of the conflicts
+int find_conflict(std::vector<int>& parent, int r){
+    while (parent[r] != r){
+        parent[r] = parent[parent[r]];
+        r = parent[r];
+    }
+    return r;
+}
+
+void repair_used_routes(std::vector<Route>& routes, const std::vector<int>& used_routes, const Instance& instance) {
     using std::vector;
 
-    // For every intervention, build a vector of the routes that cover it
+    // For every intervention, build a vector of the used routes that cover it, from their sequences
     int n_interventions = instance.number_interventions;
     vector<vector<int>> routes_covering_intervention = vector<vector<int>>(n_interventions);
-    for (int r = 0; r < routes.size(); r++){
-        for (int i = 0; i < n_interventions; i++){
-            if (solution.coefficients[r] > 0 && routes[r].is_in_route[i] > 0){
-                routes_covering_intervention[i].push_back(r);
-            }
+    for (int r : used_routes){
+        for (int k = 1; k + 1 < routes[r].id_sequence.size(); k++){
+            routes_covering_intervention[routes[r].id_sequence[k]].push_back(r);
         }
     }
 
-    // Finally, process the routes that cover it and remove the intervention where adventageous
+    // Group the interventions covered more than once into independent conflicts :
+    // two interventions are in the same conflict if they are linked by a chain of routes covering them
+    vector<int> parent(routes.size());
+    for (int r : used_routes){
+        parent[r] = r;
+    }
+    for (int i = 0; i < n_interventions; i++){
+        const vector<int>& covering = routes_covering_intervention[i];
+        for (int j = 1; j < covering.size(); j++){
+            parent[find_conflict(parent, covering[j])] = find_conflict(parent, covering[0]);
+        }
+    }
+    vector<int> conflict_index(routes.size(), -1);
+    vector<vector<int>> conflicts;
     for (int i = 0; i < n_interventions; i++){
         if (routes_covering_intervention[i].size() <= 1){
             continue;
         }
-        // If there are multiple routes covering the intervention, compute the "delta" of removing the intervention from each route
-        vector<double> delta = vector<double>(routes_covering_intervention[i].size());
-        for (int r = 0; r < routes_covering_intervention[i].size(); r++){
-            Route& route = routes[routes_covering_intervention[i][r]];
-            delta[r] = compute_delta(route, i , instance);
+        int root = find_conflict(parent, routes_covering_intervention[i][0]);
+        if (conflict_index[root] == -1){
+            conflict_index[root] = conflicts.size();
+            conflicts.push_back({});
+        }
+        conflicts[conflict_index[root]].push_back(i);
+    }
+
+    // Schedules of the used routes, to evaluate the removals in constant time
+    vector<RouteSchedule> schedules(routes.size());
+    parallel_for(used_routes.size(), [&](int k){
+        schedules[used_routes[k]] = schedule_route(routes[used_routes[k]], instance);
+    });
+
+    // Finally, process the routes that cover each intervention and remove it where adventageous
+    // The conflicts do not share any route, and the interventions of a conflict are processed in increasing order
+    parallel_for(conflicts.size(), [&](int c){
+        for (int i : conflicts[c]){
+            remove_duplicate_covering(i, routes_covering_intervention[i], routes, schedules, instance);
         }
-        // Sort the routes by the delta
-        vector<int> indexes(routes_covering_intervention[i].size());
-        std::iota(indexes.begin(), indexes.end(), 0);
-        std::sort(indexes.begin(), indexes.end(), [&delta](int i1, int i2) {return delta[i1] > delta[i2];});
-
-        // Remove the intervention from all the routes except the one with the highest delta
-        for (int j = 0; j < indexes.size() - 1; j++){
-            int r = routes_covering_intervention[i][indexes[j]];
-            delete_intervention(routes[r], i, instance);
+    });
+}
+
+void repair_routes(std::vector<Route>& routes, IntegerSolution& solution, const Instance& instance) {
+    using std::vector;
+
+    vector<int> used_routes;
+    for (int r = 0; r < solution.coefficients.size(); r++){
+        if (solution.coefficients[r] > 0){
+            used_routes.push_back(r);
         }
     }
+    repair_used_routes(routes, used_routes, instance);
 
     // Remove the routes that are empty
-    for (int r = 0; r < routes.size(); r++){
+    for (int r : used_routes){
         if (routes[r].id_sequence.size() == 2){
             solution.coefficients[r] = 0;
         }
@@ -90,61 +160,26 @@ void repair_routes(std::vector<Route>& routes, IntegerSolution& solution, const
     solution.objective_value = compute_integer_objective(solution, routes, instance, true);
 }
 
-std::pair<IntegerSolution, std::vector<Route>> compute_repaired_solution(const std::vector<Route>& routes, const IntegerSolution& solution, const Instance& instance){
+std::pair<IntegerSolution, std::vector<Route>> extract_used_routes(const std::vector<Route>& routes, const IntegerSolution& solution){
     using std::vector;
 
-    // Create a vector containing only the routes used in the initial solution
     vector<Route> used_routes;
-    IntegerSolution repaired_solution = AllOnesSolution(used_routes.size());
-    for (int r = 0; r < routes.size(); r++){
+    for (int r = 0; r < solution.coefficients.size(); r++){
         if (solution.coefficients[r] > 0){
             used_routes.push_back(routes[r]);
         }
     }
+    IntegerSolution used_solution = AllOnesSolution(used_routes.size());
+    used_solution.objective_value = solution.objective_value;
+    used_solution.is_feasible = solution.is_feasible;
+    return std::make_pair(used_solution, used_routes);
+}
 
-    // For every intervention, build a vector of the routes that cover it
-    int n_interventions = instance.number_interventions;
-    vector<vector<int>> routes_covering_intervention = vector<vector<int>>(n_interventions);
-    for (int r = 0; r < used_routes.size(); r++){
-        for (int i = 0; i < n_interventions; i++){
-            if (solution.coefficients[r] > 0 && used_routes[r].is_in_route[i] > 0){
-                routes_covering_intervention[i].push_back(r);
-            }
-        }
-    }
-
-    // Finally, process the routes that cover it and remove the intervention where adventageous
-    for (int i = 0; i < n_interventions; i++){
-        if (routes_covering_intervention[i].size() <= 1){
-            continue;
-        }
-        // If there are multiple routes covering the intervention, compute the "delta" of removing the intervention from each route
-        vector<double> delta = vector<double>(routes_covering_intervention[i].size());
-        for (int r = 0; r < routes_covering_intervention[i].size(); r++){
-            Route& route = used_routes[routes_covering_intervention[i][r]];
-            delta[r] = compute_delta(route, i , instance);
-        }
-        // Sort the routes by the delta
-        vector<int> indexes(routes_covering_intervention[i].size());
-        std::iota(indexes.begin(), indexes.end(), 0);
-        std::sort(indexes.begin(), indexes.end(), [&delta](int i1, int i2) {return delta[i1] > delta[i2];});
-
-        // Remove the intervention from all the routes except the one with the highest delta
-        for (int j = 0; j < indexes.size() - 1; j++){
-            int r = routes_covering_intervention[i][indexes[j]];
-            delete_intervention(used_routes[r], i, instance);
-        }
-    }
-
-    // Remove the routes that are empty
-    for (int r = 0; r < used_routes.size(); r++){
-        if (routes[r].id_sequence.size() == 2){
-            repaired_solution.coefficients[r] = 0;
-        }
+std::pair<IntegerSolution, std::vector<Route>> compute_repaired_solution(const std::vector<Route>& routes, const IntegerSolution& solution, const Instance& instance){
+    // Only the routes used in the initial solution are copied and repaired
+    auto [repaired_solution, used_routes] = extract_used_routes(routes, solution);
+    if (repaired_solution.is_feasible){
+        repair_routes(used_routes, repaired_solution, instance);
     }
-
-    // Update the cost of the solution
-    repaired_solution.objective_value = compute_integer_objective(solution, routes, instance, true);
-
     return std::make_pair(repaired_solution, used_routes);
-}
\ No newline at end of file
+}
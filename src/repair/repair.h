@@ -20,13 +20,25 @@ double compute_delta(const Route& route, int intervention, const Instance& insta
 // @param intervention The intervention we want to remove
 void delete_intervention(Route& route, int intervention, const Instance& instance);
 
+// Repairs the given routes by removing duplicate intervention coverings, in place
+// Only the routes of used_routes (indices in the routes vector) are read and modified
+// The interventions covered more than once are grouped in independent conflicts (sets of routes linked by
+// shared interventions), that are processed in parallel
+// Each removal is evaluated in constant time on the schedule of the route (see route_evaluation.h)
+// The removals that would make a route infeasible are skipped (the intervention then stays covered more than once)
+void repair_used_routes(std::vector<Route>& routes, const std::vector<int>& used_routes, const Instance& instance);
+
 // Given a vector of routes and a corresponding IntegerSolution
 // Repairs the solution by removing duplicate intervention coverings from the route
 // If the triangle inequality is respected, this can only improve the solution
-// Modifies only the routes used in the initial solution
+// Modifies only the routes used in the initial solution (see repair_used_routes)
 // Eventually, if after repair a route becomes empty, its coefficient in the solution is set to 0
 void repair_routes(std::vector<Route>& routes, IntegerSolution& solution, const Instance& instance);
 
 
+// Copies only the routes used in the solution, with the matching solution (all coefficients set to 1, same objective value)
+std::pair<IntegerSolution, std::vector<Route>> extract_used_routes(const std::vector<Route>& routes, const IntegerSolution& solution);
+
 // Comutes a repaired solution from the initial solution and routes, without modifying the initial solution nor the routes
-std::pair<IntegerSolution, std::vector<Route>> compute_repaired_solution(const std::vector<Route>& routes, const IntegerSolution& solution, const Instance& instance);
\ No newline at end of file
+// Only the used routes are copied : the returned solution is indexed by the returned routes
+std::pair<IntegerSolution, std::vector<Route>> compute_repaired_solution(const std::vector<Route>& routes, const IntegerSolution& solution, const Instance& instance);
@@ -1,4 +1,5 @@
 #include "route.h"
+#include "route_evaluation.h"
 
 #include "master_problem/master.h"
 #include "instance/constants.h"
@@ -149,7 +150,7 @@ double compute_reduced_cost(const Route& route, const std::vector<double>& alpha
 // - The route starts and ends at the depot
 // - The route respects the time windows of the interventions
 // - The route respects the capacities of the vehicles
-bool is_route_feasible(const Route& route, const Instance& instance) {
+bool is_route_feasible(const Route& route, const Instance& instance, bool verbose) {
     using std::cout, std::endl;
     using std::map, std::string;
 
@@ -162,17 +163,18 @@ bool is_route_feasible(const Route& route, const Instance& instance) {
     }
     // Check that the route starts and ends at the depot
     if (route.id_sequence.front() != depot_id) {
-        cout << "Route does not start at the depot" << endl;
+        if (verbose) cout << "Route does not start at the depot" << endl;
         return false;
     }
     if (route.id_sequence.back() != depot_id) {
-        cout << "Route does not end at the depot" << endl;
+        if (verbose) cout << "Route does not end at the depot" << endl;
         return false;
     }
     // We now go through the route step by step to check the time windows and the capacities
     int route_length = route.id_sequence.size();
     int current_time = 0;
-    map<string, int> consummed_capacities;
+    // Indexed as the capacities labels of the instance
+    std::vector<int> consummed_capacities(instance.capacities_labels.size(), 0);
     // Go through every consecutive intervention in the route
     for (int i = 0; i < route_length - 1; i++) {
         int intervention_id = route.id_sequence.at(i);
@@ -180,19 +182,19 @@ bool is_route_feasible(const Route& route, const Instance& instance) {
         // Check that the skills are respected
         bool can_do = can_do_intervention(intervention, vehicle);
         if (!can_do) {
-            cout << "Vehicle " << vehicle_id << " cannot do intervention " << intervention_id << endl;
+            if (verbose) cout << "Vehicle " << vehicle_id << " cannot do intervention " << intervention_id << endl;
             return false;
         }
         // Check that the time window is respected
         double duration = intervention.duration;
         // Check that intervention ends before the end of its time window
         if (current_time + duration > intervention.end_window) {
-            cout << "Intervention" << intervention_id << " ends too late : " << current_time + duration << " > " << intervention.end_window << endl;
+            if (verbose) cout << "Intervention" << intervention_id << " ends too late : " << current_time + duration << " > " << intervention.end_window << endl;
             return false;
         }
         // Update the quantities consummed
-        for (auto& [key, value] : intervention.quantities) {
-            consummed_capacities[key] += value;
+        for (int r = 0; r < consummed_capacities.size(); r++) {
+            consummed_capacities[r] += intervention.quantity_values[r];
         }
         // Update the current time
         int next_intervention_id = route.id_sequence[i + 1];
@@ -210,17 +212,14 @@ bool is_route_feasible(const Route& route, const Instance& instance) {
     }
     // Check the final intervention, we only have to check the end window
     if (current_time > END_DAY) {
-        cout << "Final intervention ends too late : " << current_time << " > " << END_DAY << endl;
+        if (verbose) cout << "Final intervention ends too late : " << current_time << " > " << END_DAY << endl;
         return false;
     }
     // Finally, check that the capacities are respected
-    for (const auto& [key, value] : consummed_capacities) {
-        // If the key is not in the capacities, we don't care
-        if (vehicle.capacities.find(key) == vehicle.capacities.end()) {
-            continue;
-        }
-        if (value > vehicle.capacities.at(key)) {
-            cout << "Capacity " << key << " is exceeded" << endl;
+    // (only the capacities labels of the instance are checked)
+    for (int r = 0; r < consummed_capacities.size(); r++) {
+        if (consummed_capacities[r] > vehicle.capacity_values[r]) {
+            if (verbose) cout << "Capacity " << instance.capacities_labels[r] << " is exceeded" << endl;
             return false;
         }
     }
@@ -229,56 +228,13 @@ bool is_route_feasible(const Route& route, const Instance& instance) {
 }
 
 std::vector<int> compute_start_times(const Route& route, const Instance& instance) {
-    // We go through the route and compute the start times of the interventions
-    std::vector<int> start_times;
-    int current_time = 0;
-    for (int i = 0; i < route.id_sequence.size() - 1; i++) {
-        // We just arrived at the intervention - push the current time
-        start_times.push_back(current_time);
-        // Update the current time
-        int intervention_id = route.id_sequence[i];
-        const Node& intervention = instance.nodes[intervention_id];
-        current_time += intervention.duration;
-        // Add the travel time to the next intervention
-        int next_intervention_id = route.id_sequence[i + 1];
-        const Node& next_intervention = instance.nodes[next_intervention_id];
-        current_time += instance.time_matrix[intervention_id][next_intervention_id];
-        // And the eventual waiting time
-        current_time = std::max(current_time, next_intervention.start_window);
-        // And the eventual waiting out of the lunch break
-        if (next_intervention.is_ambiguous && current_time < MID_DAY &&  current_time + next_intervention.duration > MID_DAY) {
-            current_time = MID_DAY;
-        }
-    }
-    // Treat the last intervention
-    start_times.push_back(current_time);
-
-    return start_times;
+    // The forward pass of the schedule gives the start times (and the arrival time at the depot)
+    return schedule_route(route, instance).earliest_start;
 }
 
 int compute_total_waiting_time(const Route& route, const Instance& instance) {
-    // We go through the route and compute the total waiting time
-    int total_waiting_time = 0;
-    int current_time = 0;
-    for (int i = 0; i < route.id_sequence.size() - 1; i++) {
-        // Update the current time
-        int intervention_id = route.id_sequence[i];
-        const Node& intervention = instance.nodes[intervention_id];
-        current_time += intervention.duration;
-        // Add the travel time to the next intervention
-        int next_intervention_id = route.id_sequence[i + 1];
-        const Node& next_intervention = instance.nodes[next_intervention_id];
-        current_time += instance.time_matrix[intervention_id][next_intervention_id];
-        // And the eventual waiting time
-        total_waiting_time += std::max(0, next_intervention.start_window - current_time);
-        current_time = std::max(current_time, next_intervention.start_window);
-        // And the eventual waiting out of the lunch break
-        if (next_intervention.is_ambiguous && current_time < MID_DAY &&  current_time + next_intervention.duration > MID_DAY) {
-            total_waiting_time += MID_DAY - current_time;
-            current_time = MID_DAY;
-        }
-    }
-    return total_waiting_time;
+    RouteSchedule schedule = schedule_route(route, instance);
+    return schedule.cumulated_waiting.empty() ? 0 : schedule.cumulated_waiting.back();
 }
 
 int compute_total_travelling_time(const Route& route, const Instance& instance) {
@@ -56,7 +56,8 @@ int count_route_duration(const Route& route, const Instance& instance);
 double compute_reduced_cost(const Route& route, const std::vector<double>& alphas, double beta, const Instance& instance);
 
 // Checks if a route is feasible
-bool is_route_feasible(const Route& route, const Instance& instance);
+// If verbose, prints the reason why the route is not feasible
+bool is_route_feasible(const Route& route, const Instance& instance, bool verbose = true);
 
 // Returns a vector of the start times of the nodes along the route's sequence
 std::vector<int> compute_start_times(const Route& route, const Instance& instance);
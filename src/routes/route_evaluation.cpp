@@ -0,0 +1,158 @@
+#include "route_evaluation.h"
+
+#include "instance/preprocessing.h"
+#include "instance/constants.h"
+
+#include <vector>
+#include <algorithm>
+
+
+RouteSchedule schedule_route(const std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle) {
+    using std::vector, std::min;
+    RouteSchedule schedule;
+    schedule.sequence = sequence;
+    schedule.consumption.assign(instance.capacities_labels.size(), 0);
+    int n = sequence.size();
+    if (n == 0) {
+        return schedule;
+    }
+    schedule.earliest_start.resize(n);
+    schedule.latest_start.resize(n);
+    schedule.cumulated_waiting.resize(n);
+
+    // Forward pass : earliest start times, waiting times and consumed capacities
+    schedule.earliest_start[0] = 0;
+    schedule.cumulated_waiting[0] = 0;
+    for (int k = 1; k < n; k++) {
+        const Node& previous = instance.nodes[sequence[k - 1]];
+        const Node& node = instance.nodes[sequence[k]];
+        int arrival = schedule.earliest_start[k - 1] + previous.duration + instance.time_matrix[sequence[k - 1]][sequence[k]];
+        int start = k == n - 1 ? arrival : earliest_start(node, arrival);
+        schedule.earliest_start[k] = start;
+        schedule.cumulated_waiting[k] = schedule.cumulated_waiting[k - 1] + start - arrival;
+        schedule.distance += instance.distance_matrix[sequence[k - 1]][sequence[k]];
+        if (k == n - 1) {
+            schedule.is_feasible &= start <= END_DAY;
+        } else {
+            schedule.is_feasible &= start + node.duration <= node.end_window;
+            for (int r = 0; r < schedule.consumption.size(); r++) {
+                schedule.consumption[r] += node.quantity_values[r];
+            }
+        }
+    }
+    for (int r = 0; r < schedule.consumption.size(); r++) {
+        schedule.is_feasible &= schedule.consumption[r] <= vehicle.capacity_values[r];
+    }
+
+    // Backward pass : latest start times
+    schedule.latest_start[n - 1] = END_DAY;
+    for (int k = n - 2; k >= 0; k--) {
+        const Node& node = instance.nodes[sequence[k]];
+        int next_arrival = k == n - 2 ? schedule.latest_start[n - 1] : latest_arrival(instance.nodes[sequence[k + 1]], schedule.latest_start[k + 1]);
+        int latest = next_arrival < 0 ? -1 : min(node.end_window - node.duration, next_arrival - instance.time_matrix[sequence[k]][sequence[k + 1]] - node.duration);
+        schedule.latest_start[k] = std::max(latest, -1);
+    }
+    return schedule;
+}
+
+
+RouteSchedule schedule_route(const Route& route, const Instance& instance) {
+    if (route.id_sequence.empty()) {
+        RouteSchedule schedule;
+        schedule.consumption.assign(instance.capacities_labels.size(), 0);
+        return schedule;
+    }
+    return schedule_route(route.id_sequence, instance, instance.vehicles[route.vehicle_id]);
+}
+
+
+int latest_arrival(const Node& node, int latest_start) {
+    int arrival = latest_start;
+    // An ambiguous intervention started in the morning must be over by the lunch break
+    if (node.is_ambiguous && latest_start < MID_DAY) {
+        arrival = std::min(arrival, MID_DAY - node.duration);
+    }
+    // Arriving earlier only means waiting for the start of the time window
+    return arrival >= node.start_window ? arrival : -1;
+}
+
+
+// Latest arrival at the node of the sequence at the given position
+int latest_arrival_at(const RouteSchedule& schedule, int position, const Instance& instance) {
+    if (position == schedule.sequence.size() - 1) {
+        return schedule.latest_start[position];
+    }
+    return latest_arrival(instance.nodes[schedule.sequence[position]], schedule.latest_start[position]);
+}
+
+
+// Can the intervention be done between the nodes at positions previous and next of the sequence
+bool fits_between(const RouteSchedule& schedule, int previous, int next, int intervention, const Instance& instance) {
+    const Node& node = instance.nodes[intervention];
+    int previous_node = schedule.sequence[previous];
+    int next_node = schedule.sequence[next];
+    int arrival = schedule.earliest_start[previous] + instance.nodes[previous_node].duration + instance.time_matrix[previous_node][intervention];
+    int start = earliest_start(node, arrival);
+    int next_arrival = latest_arrival_at(schedule, next, instance);
+    if (next_arrival < 0) {
+        return false;
+    }
+    int latest = std::min(node.end_window - node.duration, next_arrival - instance.time_matrix[intervention][next_node] - node.duration);
+    return start <= latest;
+}
+
+
+bool is_insertion_feasible(const RouteSchedule& schedule, int position, int intervention, const Instance& instance, const Vehicle& vehicle) {
+    const Node& node = instance.nodes[intervention];
+    for (int r = 0; r < schedule.consumption.size(); r++) {
+        if (schedule.consumption[r] + node.quantity_values[r] > vehicle.capacity_values[r]) {
+            return false;
+        }
+    }
+    return fits_between(schedule, position - 1, position, intervention, instance);
+}
+
+
+bool is_removal_feasible(const RouteSchedule& schedule, int position, const Instance& instance) {
+    // Without the triangle inequality, going directly to the next node may take longer
+    int previous_node = schedule.sequence[position - 1];
+    int next_node = schedule.sequence[position + 1];
+    int arrival = schedule.earliest_start[position - 1] + instance.nodes[previous_node].duration + instance.time_matrix[previous_node][next_node];
+    return arrival <= latest_arrival_at(schedule, position + 1, instance);
+}
+
+
+bool is_replacement_feasible(const RouteSchedule& schedule, int position, int intervention, const Instance& instance, const Vehicle& vehicle) {
+    const Node& node = instance.nodes[intervention];
+    const Node& removed = instance.nodes[schedule.sequence[position]];
+    for (int r = 0; r < schedule.consumption.size(); r++) {
+        if (schedule.consumption[r] - removed.quantity_values[r] + node.quantity_values[r] > vehicle.capacity_values[r]) {
+            return false;
+        }
+    }
+    return fits_between(schedule, position - 1, position + 1, intervention, instance);
+}
+
+
+int insertion_distance(const RouteSchedule& schedule, int position, int intervention, const Instance& instance) {
+    int previous = schedule.sequence[position - 1];
+    int next = schedule.sequence[position];
+    return instance.distance_matrix[previous][intervention] + instance.distance_matrix[intervention][next] - instance.distance_matrix[previous][next];
+}
+
+
+int removal_distance(const RouteSchedule& schedule, int position, const Instance& instance) {
+    int previous = schedule.sequence[position - 1];
+    int removed = schedule.sequence[position];
+    int next = schedule.sequence[position + 1];
+    return instance.distance_matrix[previous][next] - instance.distance_matrix[previous][removed] - instance.distance_matrix[removed][next];
+}
+
+
+int replacement_distance(const RouteSchedule& schedule, int position, int intervention, const Instance& instance) {
+    int previous = schedule.sequence[position - 1];
+    int removed = schedule.sequence[position];
+    int next = schedule.sequence[position + 1];
+    return instance.distance_matrix[previous][intervention] + instance.distance_matrix[intervention][next]
+        - instance.distance_matrix[previous][removed] - instance.distance_matrix[removed][next];
+}
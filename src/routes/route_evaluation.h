@@ -0,0 +1,65 @@
+#pragma once
+
+#include "instance/instance.h"
+#include "routes/route.h"
+
+#include <vector>
+
+
+/*
+    @struct RouteSchedule
+    @brief Forward and backward time data of a route, to evaluate the moves on the route in constant time
+
+    The forward data is the earliest start of every node, the backward data the latest start of every node
+    that keeps the end of the route feasible (time windows, lunch break and return to the depot before END_DAY)
+    Inserting, removing or replacing an intervention is feasible if the new intervention can start before its
+    latest start, and the next node of the sequence can be reached before its own latest start
+*/
+struct RouteSchedule {
+    // Sequence of the nodes, starting and ending at the depot (as Route::id_sequence)
+    std::vector<int> sequence;
+    // Earliest start time of each node of the sequence (the arrival time for the final depot)
+    std::vector<int> earliest_start;
+    // Latest start time of each node such that the rest of the route is feasible (-1 if there is none)
+    std::vector<int> latest_start;
+    // Waiting time accumulated along the route when starting each node
+    std::vector<int> cumulated_waiting;
+    // Capacities consumed along the whole route, indexed as the capacities labels of the instance
+    std::vector<int> consumption;
+    // Total distance of the route
+    int distance = 0;
+    // Does the route respect the time windows, the lunch break and the capacities
+    bool is_feasible = true;
+};
+
+
+// Computes the schedule of a sequence of nodes starting and ending at the depot of the vehicle
+// The vehicle leaves its depot at time 0, and waits for the end of the lunch break before the ambiguous interventions
+// (same rules as is_route_feasible, the skills are not checked)
+RouteSchedule schedule_route(const std::vector<int>& sequence, const Instance& instance, const Vehicle& vehicle);
+
+// Computes the schedule of a route (empty if the route is empty)
+RouteSchedule schedule_route(const Route& route, const Instance& instance);
+
+
+// Latest arrival time at a node such that it can start before latest_start
+// Returns -1 if no arrival time allows it
+int latest_arrival(const Node& node, int latest_start);
+
+
+// The moves below are evaluated on a feasible schedule, in constant time
+// The interventions added must be doable by the vehicle (skills and vehicle.interventions are not checked)
+
+// Can the intervention be inserted just before the node at the given position of the sequence (1 <= position < sequence size)
+bool is_insertion_feasible(const RouteSchedule& schedule, int position, int intervention, const Instance& instance, const Vehicle& vehicle);
+
+// Can the intervention at the given position be removed (1 <= position < sequence size - 1)
+bool is_removal_feasible(const RouteSchedule& schedule, int position, const Instance& instance);
+
+// Can the intervention at the given position be replaced by another intervention (1 <= position < sequence size - 1)
+bool is_replacement_feasible(const RouteSchedule& schedule, int position, int intervention, const Instance& instance, const Vehicle& vehicle);
+
+// Variation of the distance of the route for the same moves
+int insertion_distance(const RouteSchedule& schedule, int position, int intervention, const Instance& instance);
+int removal_distance(const RouteSchedule& schedule, int position, const Instance& instance);
+int replacement_distance(const RouteSchedule& schedule, int position, int intervention, const Instance& instance);
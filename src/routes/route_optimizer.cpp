@@ -7,11 +7,152 @@
 
 #include "data_analysis/analysis.h"
 
+#include "instance/preprocessing.h"
+#include "instance/parallel.h"
+#include "instance/constants.h"
+
 #include <chrono>
 #include <vector>
+#include <limits>
+#include <algorithm>
 #include "gurobi_c++.h"
 
+
+// Label of the dynamic programming : partial route over a subset of the interventions, ending at a given intervention
+struct SequenceLabel {
+    // Distance from the depot
+    int distance;
+    // Start time of the last intervention
+    int time;
+    // Previous intervention (index in the interventions vector, -1 for the depot) and its label
+    int previous;
+    int previous_label;
+};
+
+
+std::vector<int> shortest_feasible_sequence(const std::vector<int>& interventions, const Instance& instance, const Vehicle& vehicle) {
+    using std::vector;
+    int n = interventions.size();
+    if (n == 0) {
+        return {};
+    }
+    int n_subsets = 1 << n;
+    // Pareto front (distance, time) of the labels of every (subset, last intervention), sorted by increasing time
+    vector<vector<SequenceLabel>> labels((size_t) n_subsets * n);
+    auto state = [n](int subset, int last) {return (size_t) subset * n + last;};
+
+    // Adds a label to a front, unless it is dominated ; removes the labels it dominates
+    auto add_label = [](vector<SequenceLabel>& front, const SequenceLabel& label) {
+        for (const SequenceLabel& other : front) {
+            if (other.distance <= label.distance && other.time <= label.time) {
+                return;
+            }
+        }
+        std::erase_if(front, [&label](const SequenceLabel& other) {
+            return label.distance <= other.distance && label.time <= other.time;
+        });
+        front.insert(std::upper_bound(front.begin(), front.end(), label, [](const SequenceLabel& a, const SequenceLabel& b) {return a.time < b.time;}), label);
+    };
+
+    // Routes from the depot to each intervention
+    for (int k = 0; k < n; k++) {
+        const Node& node = instance.nodes[interventions[k]];
+        int start = earliest_start(node, instance.time_matrix[vehicle.depot][interventions[k]]);
+        if (start + node.duration <= node.end_window) {
+            labels[state(1 << k, k)].push_back({instance.distance_matrix[vehicle.depot][interventions[k]], start, -1, -1});
+        }
+    }
+    // Extend the labels by increasing subsets (a subset is always processed before its supersets)
+    for (int subset = 1; subset < n_subsets; subset++) {
+        for (int j = 0; j < n; j++) {
+            const vector<SequenceLabel>& front = labels[state(subset, j)];
+            if (front.empty()) continue;
+            int true_j = interventions[j];
+            for (int k = 0; k < n; k++) {
+                if (subset & (1 << k)) continue;
+                int true_k = interventions[k];
+                const Node& node = instance.nodes[true_k];
+                vector<SequenceLabel>& next_front = labels[state(subset | (1 << k), k)];
+                for (int l = 0; l < front.size(); l++) {
+                    int arrival = front[l].time + instance.nodes[true_j].duration + instance.time_matrix[true_j][true_k];
+                    int start = earliest_start(node, arrival);
+                    // The labels are sorted by time : the next ones can not reach k either
+                    if (start + node.duration > node.end_window) break;
+                    add_label(next_front, {front[l].distance + instance.distance_matrix[true_j][true_k], start, j, l});
+                }
+            }
+        }
+    }
+
+    // Best complete route, coming back to the depot before the end of the day
+    int full = n_subsets - 1;
+    int best_distance = std::numeric_limits<int>::max();
+    int best_last = -1;
+    int best_label = -1;
+    for (int j = 0; j < n; j++) {
+        const vector<SequenceLabel>& front = labels[state(full, j)];
+        for (int l = 0; l < front.size(); l++) {
+            int true_j = interventions[j];
+            if (front[l].time + instance.nodes[true_j].duration + instance.time_matrix[true_j][vehicle.depot] > END_DAY) continue;
+            int distance = front[l].distance + instance.distance_matrix[true_j][vehicle.depot];
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_last = j;
+                best_label = l;
+            }
+        }
+    }
+    if (best_last == -1) {
+        return {};
+    }
+    // Walk back the labels
+    vector<int> sequence;
+    int subset = full;
+    while (best_last != -1) {
+        const SequenceLabel& label = labels[state(subset, best_last)][best_label];
+        sequence.push_back(interventions[best_last]);
+        subset ^= 1 << best_last;
+        best_last = label.previous;
+        best_label = label.previous_label;
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return sequence;
+}
+
+
 Route optimize_route(const Route& route, const Instance& instance) {
+    using std::vector;
+    // If the route is empty, skip the optimization
+    if (route.id_sequence.size() <= 2) {
+        return route;
+    }
+    // Larger routes are optimized with the MIP
+    vector<int> interventions(route.id_sequence.begin() + 1, route.id_sequence.end() - 1);
+    if (interventions.size() > MAX_EXACT_ROUTE_SIZE) {
+        return optimize_route_mip(route, instance);
+    }
+    const Vehicle& vehicle = instance.vehicles[route.vehicle_id];
+    vector<int> sequence = shortest_feasible_sequence(interventions, instance, vehicle);
+    if (sequence.empty()) {
+        return route;
+    }
+    // Convert it to in-vehicle indices, with the depot at both ends
+    vector<int> vehicle_sequence = {-1};
+    for (int i : sequence) {
+        vehicle_sequence.push_back(vehicle.reverse_interventions[i]);
+    }
+    vehicle_sequence.push_back(-1);
+    Route optimized_route = convert_sequence_to_route(route.reduced_cost, vehicle_sequence, instance, vehicle);
+
+    // If we did not improve, return the initial route
+    if (count_route_kilometres(optimized_route, instance) >= count_route_kilometres(route, instance)) {
+        return route;
+    }
+    return optimized_route;
+}
+
+
+Route optimize_route_mip(const Route& route, const Instance& instance) {
     using namespace std;
 
     // If the route is empty, skip the optimization
@@ -30,8 +171,10 @@ Route optimize_route(const Route& route, const Instance& instance) {
 
     try {
         // Create the model
+        // The routes are optimized in parallel (see optimize_routes) : each model only uses one thread
         GRBEnv env = GRBEnv(true);
         env.set(GRB_IntParam_OutputFlag, 0);
+        env.set(GRB_IntParam_Threads, 1);
         env.start();
         GRBModel model = GRBModel(env);
 
@@ -189,14 +332,23 @@ IntegerSolution optimize_routes(const IntegerSolution& integer_solution, std::ve
     auto start = chrono::steady_clock::now();
     int n_changed = 0;
     double km_saved = 0;
+    std::vector<int> used_routes;
     for (int r = 0; r < routes.size(); r++) {
         if (integer_solution.coefficients[r] > 0) {
-            Route optimized_route = optimize_route(routes[r], instance);
-            km_saved += count_route_kilometres(routes[r], instance) - count_route_kilometres(optimized_route, instance);
-            if (!(optimized_route == routes[r])) {
-                routes[r] = optimized_route;
-                n_changed++;              
-            }
+            used_routes.push_back(r);
+        }
+    }
+    // The routes are independent : optimize them in parallel
+    std::vector<Route> optimized_routes(used_routes.size());
+    parallel_for(used_routes.size(), [&](int k) {
+        optimized_routes[k] = optimize_route(routes[used_routes[k]], instance);
+    });
+    for (int k = 0; k < used_routes.size(); k++) {
+        int r = used_routes[k];
+        km_saved += count_route_kilometres(routes[r], instance) - count_route_kilometres(optimized_routes[k], instance);
+        if (!(optimized_routes[k] == routes[r])) {
+            routes[r] = optimized_routes[k];
+            n_changed++;
         }
     }
 
@@ -4,9 +4,27 @@
 #include "routes/route.h"
 #include "master_problem/master.h"
 
+#include <vector>
+
+// Maximum number of interventions of the routes optimized by dynamic programming (the larger ones use the MIP)
+inline constexpr int MAX_EXACT_ROUTE_SIZE = 15;
+
+
+// Shortest order of a set of interventions respecting the time windows and the lunch break (same rules as is_route_feasible)
+// Exact dynamic programming over the subsets of interventions, keeping the Pareto front of (distance, start time) for each
+// subset and last intervention : waiting is never useful, so the earliest start times are enough
+// The interventions are indices in the nodes vector, and so is the returned sequence (without the depot)
+// Returns an empty sequence if no order is feasible
+std::vector<int> shortest_feasible_sequence(const std::vector<int>& interventions, const Instance& instance, const Vehicle& vehicle);
+
+
 // Optimize a route for travel distance
+// Uses shortest_feasible_sequence for the routes of at most MAX_EXACT_ROUTE_SIZE interventions, optimize_route_mip otherwise
 Route optimize_route(const Route& route, const Instance& instance);
 
+// Optimize a route for travel distance with a MIP solved by Gurobi
+Route optimize_route_mip(const Route& route, const Instance& instance);
+
 
 // Optimizes the routes in a given integer solution and returns the new integer solution
 // Also updates the routes vector with the optimized routes